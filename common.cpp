@@ -107,3 +107,111 @@ vector<word> makePermutationFromScheme(ReversibleLogic::Scheme scheme,
 
     return table;
 }
+
+ReversibleLogic::Scheme parseSchemeFile(const string& fileName,
+    ReversibleLogic::TfcFormatter* formatter, uint* variablesCount)
+{
+    using namespace ReversibleLogic;
+
+    assertd(formatter && variablesCount, string("parseSchemeFile(): null ptr"));
+
+    Scheme scheme;
+    if (BinarySchemeReader::isBinarySchemeFile(fileName))
+    {
+        BinarySchemeReader reader;
+        reader.open(fileName);
+
+        scheme = reader.readAll();
+        *variablesCount = reader.getLineCount();
+        return scheme;
+    }
+
+    ifstream inputFile(fileName);
+    assert(inputFile.is_open(),
+        string("Failed to open input file \"") + fileName + "\" for reading");
+
+    if (RealFormatter::isRealFile(fileName))
+    {
+        RealFormatter realFormatter;
+        scheme = realFormatter.parse(inputFile);
+        *variablesCount = realFormatter.getVariablesCount();
+    }
+    else
+    {
+        scheme = formatter->parse(inputFile);
+        *variablesCount = formatter->getVariablesCount();
+    }
+
+    return scheme;
+}
+
+string getSchemeFileExtension()
+{
+    const ProgramOptions& options = ProgramOptions::get();
+    if (options.options.getBool("binary-scheme-output", false))
+        return ReversibleLogic::BinarySchemeReader::getFileExtension();
+
+    return ".tfc";
+}
+
+void writeSchemeFile(const ReversibleLogic::Scheme& scheme, uint variablesCount,
+    ReversibleLogic::TfcFormatter* formatter, const string& fileName)
+{
+    using namespace ReversibleLogic;
+
+    if (scheme.size())
+        variablesCount = max(variablesCount, scheme.front().getInputCount());
+
+    writeSchemeFile(variablesCount, formatter, fileName, [&scheme](GateSink* sink)
+    {
+        sink->writeElements(scheme);
+    });
+}
+
+void writeSchemeFile(uint variablesCount, ReversibleLogic::TfcFormatter* formatter,
+    const string& fileName, const function<void(ReversibleLogic::GateSink*)>& writeElements)
+{
+    using namespace ReversibleLogic;
+
+    // generators validate scheme while it is emitted, so it is written to temporary file,
+    // which replaces the output one only if all elements were written
+    string tempFileName = fileName + ".tmp";
+    bool isBinary = BinarySchemeReader::isBinarySchemeFile(fileName);
+
+    try
+    {
+        if (isBinary)
+        {
+            BinarySchemeWriter writer(tempFileName, variablesCount);
+            writeElements(&writer);
+            writer.close();
+        }
+        else
+        {
+            assertd(formatter, string("writeSchemeFile(): null ptr"));
+
+            ofstream tfcOutput(tempFileName);
+            assert(tfcOutput.is_open(),
+                string("Failed to open tfc file \"") + tempFileName + "\" for writing");
+
+            formatter->writeHeader(tfcOutput, variablesCount);
+            {
+                SchemeWriter writer(tfcOutput, SchemeWriter::wfTfc, formatter->getLineNames());
+                writeElements(&writer);
+            }
+            formatter->writeFooter(tfcOutput);
+
+            tfcOutput.close();
+        }
+    }
+    catch (...)
+    {
+        remove(tempFileName.c_str());
+        throw;
+    }
+
+    // rename() doesn't replace existing file on Windows
+    remove(fileName.c_str());
+    assert(!rename(tempFileName.c_str(), fileName.c_str()),
+        string("Failed to rename \"") + tempFileName + "\" to \"" + fileName + "\"");
+}
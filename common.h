@@ -26,3 +26,22 @@ word mask(uint first, ...);
 word binStringToInt(string value);
 string polynomialToString(word polynomial);
 vector<word> makePermutationFromScheme(ReversibleLogic::Scheme scheme, uint n);
+
+/// Parses scheme from TFC, .real or binary scheme file (chosen by extension) and returns number of its lines,
+/// @formatter gets variables of TFC file, so it could be used to write scheme back
+ReversibleLogic::Scheme parseSchemeFile(const string& fileName,
+    ReversibleLogic::TfcFormatter* formatter, uint* variablesCount);
+
+/// Returns extension of scheme files written by work modes: binary scheme extension
+/// if "binary-scheme-output" option is set, ".tfc" otherwise
+string getSchemeFileExtension();
+
+/// Writes scheme to binary scheme file or TFC file (chosen by extension) with @formatter,
+/// @variablesCount is the number of lines stored in binary file
+void writeSchemeFile(const ReversibleLogic::Scheme& scheme, uint variablesCount,
+    ReversibleLogic::TfcFormatter* formatter, const string& fileName);
+
+/// Streaming version: elements of scheme with @variablesCount lines are emitted
+/// by @writeElements right to the file sink; if it throws, no file is left
+void writeSchemeFile(uint variablesCount, ReversibleLogic::TfcFormatter* formatter,
+    const string& fileName, const function<void(ReversibleLogic::GateSink*)>& writeElements);
@@ -0,0 +1,109 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+using namespace ReversibleLogic;
+
+/// Tables of procedural generators are written as binary tables too
+void convertTruthTableGenerators(const string& outputFolder)
+{
+    const char* strTruthTableGenerator = "truth-table-generator";
+
+    const ProgramOptions& options = ProgramOptions::get();
+    if (!options.options.has(strTruthTableGenerator))
+        return;
+
+    auto specifications = options.options[strTruthTableGenerator];
+    for (auto& specification : specifications)
+    {
+        try
+        {
+            TruthTableGenerator generator;
+            TruthTable table = generator.generate<word>(specification);
+
+            // ':' is not allowed in file names
+            string fileName = specification;
+            replace(fileName.begin(), fileName.end(), ':', '_');
+
+            string outputFileName = appendPath(outputFolder,
+                fileName + BinaryTruthTable::getFileExtension());
+
+            BinaryTruthTable::write(table, generator.getInputCount(), generator.getOutputCount(),
+                outputFileName);
+
+            cout << "Truth table generator \"" << specification << "\" is written to \"";
+            cout << outputFileName << "\"" << endl;
+        }
+        catch (exception& ex)
+        {
+            cerr << ex.what() << endl;
+        }
+    }
+}
+
+void convertTruthTables()
+{
+    const char* strTruthTableInput = "truth-table-input";
+    const char* strTextTruthTableExtension = ".table";
+
+    const ProgramOptions& options = ProgramOptions::get();
+
+    // check schemes folder existence, create if not exist
+    string outputFolder = options.schemesFolder;
+    if (_access(outputFolder.c_str(), 0))
+        _mkdir(outputFolder.c_str());
+
+    convertTruthTableGenerators(outputFolder);
+
+    if (!options.options.has(strTruthTableInput))
+        return;
+
+    auto truthTableInputFiles = options.options[strTruthTableInput];
+    for (auto& truthTableInputFileName : truthTableInputFiles)
+    {
+        try
+        {
+            TruthTableParser parser;
+            TruthTable table = parser.parse<word>(truthTableInputFileName);
+
+            string fileName = getFileName(truthTableInputFileName);
+            string extension = strTextTruthTableExtension;
+            if (fileName.size() > extension.size() &&
+                fileName.compare(fileName.size() - extension.size(), extension.size(), extension) == 0)
+            {
+                fileName.resize(fileName.size() - extension.size());
+            }
+
+            string outputFileName = appendPath(outputFolder,
+                fileName + BinaryTruthTable::getFileExtension());
+
+            BinaryTruthTable::write(table, parser.getInputCount(), parser.getOutputCount(),
+                outputFileName);
+
+            cout << "Truth table \"" << truthTableInputFileName << "\" is converted to \"";
+            cout << outputFileName << "\"" << endl;
+        }
+        catch (exception& ex)
+        {
+            cerr << ex.what() << endl;
+        }
+    }
+}
@@ -276,21 +276,22 @@ void discreteLogSynthesis()
                 TruthTable table = getDiscreteLogWithPrimitiveElement(field, task.func);
 
                 GtGeneratorWithMemory generator;
-                auto scheme = generator.generateFast(table, outputFile);
+
+                uint n = 0, m = 0;
+                generator.detectBitCount(table, &n, &m);
 
                 ostringstream schemeFileNameStream;
-                schemeFileNameStream << polynomialString << '-' << taskIndex << ".tfc";
+                schemeFileNameStream << polynomialString << '-' << taskIndex << getSchemeFileExtension();
 
                 string tfcOutputFileName = appendPath(schemesFolder, schemeFileNameStream.str());
 
-                ofstream tfcOutput(tfcOutputFileName);
-                assert(tfcOutput.is_open(),
-                    string("Failed to open tfc file \"") + tfcOutputFileName + "\" for writing");
+                TfcFormatter formatter;
+                writeSchemeFile(n + m, &formatter, tfcOutputFileName, [&](GateSink* sink)
+                {
+                    generator.generateFast(table, sink, outputFile);
+                });
 
                 outputFile << "Scheme file: " << tfcOutputFileName << endl;
-
-                TfcFormatter().format(tfcOutput, scheme);
-                tfcOutput.close();
             }
         }
         catch (exception& ex)
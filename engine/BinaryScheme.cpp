@@ -0,0 +1,251 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+static const char strBinarySchemeMagic[4] = { 'R', 'L', 'S', 'C' };
+static const uint32_t numBinarySchemeVersion = 1;
+
+//////////////////////////////////////////////////////////////////////////
+// BinarySchemeWriter
+
+BinarySchemeWriter::BinarySchemeWriter(const string& fileName, uint lineCount)
+    : output(fileName, ios_base::out | ios_base::binary)
+    , lineCount(lineCount)
+    , buffer(numBufferSize)
+{
+    assert(output.is_open(),
+        string("Failed to open binary scheme file \"") + fileName + "\" for writing");
+
+    assert(lineCount <= sizeof(word) * 8,
+        string("BinarySchemeWriter(): too many lines: ") + to_string(lineCount));
+
+    // header is rewritten with actual gate count in close()
+    BinarySchemeHeader header;
+    memset(&header, 0, sizeof(header));
+    output.write((const char*)&header, sizeof(header));
+}
+
+BinarySchemeWriter::~BinarySchemeWriter()
+{
+    close();
+}
+
+void BinarySchemeWriter::writeElement(const ReverseElement& element)
+{
+    word targetMask = element.getTargetMask();
+    word controlMask = element.getControlMask();
+    word inversionMask = element.getInversionMask();
+
+    assert(countNonZeroBits(targetMask) == 1 && !(targetMask & controlMask) &&
+        (targetMask | controlMask | inversionMask) <= getFullMask(lineCount),
+        string("BinarySchemeWriter::writeElement(): invalid element"));
+
+    if (bufferSize + numMaxRecordSize > buffer.size())
+        flush();
+
+    buffer[bufferSize++] = (uint8_t)findPositiveBitPosition(targetMask);
+    appendVarint(controlMask ^ lastControlMask);
+    appendVarint(inversionMask ^ lastInversionMask);
+
+    lastControlMask = controlMask;
+    lastInversionMask = inversionMask;
+    ++gateCount;
+}
+
+void BinarySchemeWriter::close()
+{
+    if (!output.is_open())
+        return;
+
+    flush();
+
+    BinarySchemeHeader header;
+    memcpy(header.magic, strBinarySchemeMagic, sizeof(header.magic));
+    header.version = numBinarySchemeVersion;
+    header.lineCount = lineCount;
+    header.reserved = 0;
+    header.gateCount = gateCount;
+
+    output.seekp(0);
+    output.write((const char*)&header, sizeof(header));
+    output.close();
+}
+
+void BinarySchemeWriter::appendVarint(word value)
+{
+    while (value >= 0x80)
+    {
+        buffer[bufferSize++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+
+    buffer[bufferSize++] = (uint8_t)value;
+}
+
+void BinarySchemeWriter::flush()
+{
+    if (bufferSize)
+    {
+        output.write((const char*)buffer.data(), bufferSize);
+        bufferSize = 0;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// BinarySchemeReader
+
+//static
+bool BinarySchemeReader::isBinarySchemeFile(const string& fileName)
+{
+    string extension = getFileExtension();
+    return fileName.size() > extension.size() &&
+        fileName.compare(fileName.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+//static
+const char* BinarySchemeReader::getFileExtension()
+{
+    return ".bscheme";
+}
+
+void BinarySchemeReader::open(const string& theFileName)
+{
+    header = 0;
+    fileName = theFileName;
+
+    assert(file.open(fileName),
+        string("Failed to open binary scheme file \"") + fileName + "\" for reading");
+
+    const BinarySchemeHeader* fileHeader = (const BinarySchemeHeader*)file.getData();
+    if (file.getSize() < sizeof(BinarySchemeHeader) ||
+        memcmp(fileHeader->magic, strBinarySchemeMagic, sizeof(fileHeader->magic)) ||
+        fileHeader->version != numBinarySchemeVersion ||
+        fileHeader->lineCount > sizeof(word) * 8)
+    {
+        file.close();
+        throwInvalidFormat();
+    }
+
+    header = fileHeader;
+    rewind();
+}
+
+bool BinarySchemeReader::isOpen() const
+{
+    return header != 0;
+}
+
+uint BinarySchemeReader::getLineCount() const
+{
+    return (header ? header->lineCount : 0);
+}
+
+uint64_t BinarySchemeReader::getGateCount() const
+{
+    return (header ? header->gateCount : 0);
+}
+
+bool BinarySchemeReader::next(ReverseElement* element)
+{
+    assertd(header && element, string("BinarySchemeReader::next(): null ptr"));
+
+    if (gateIndex == header->gateCount)
+    {
+        // trailing bytes mean that gate count in header is wrong
+        if (current != end)
+            throwInvalidFormat();
+
+        return false;
+    }
+
+    if (current == end)
+        throwInvalidFormat();
+
+    uint n = header->lineCount;
+    uint target = *current++;
+
+    controlMask ^= readVarint();
+    inversionMask ^= readVarint();
+
+    word targetMask = (word)1 << (target & (sizeof(word) * 8 - 1));
+    if (target >= n || (targetMask & controlMask) ||
+        (controlMask | inversionMask) > getFullMask(n))
+    {
+        throwInvalidFormat();
+    }
+
+    *element = ReverseElement(n, targetMask, controlMask, inversionMask);
+    ++gateIndex;
+
+    return true;
+}
+
+void BinarySchemeReader::rewind()
+{
+    assertd(header, string("BinarySchemeReader: file is not opened"));
+
+    current = (const uint8_t*)(header + 1);
+    end = (const uint8_t*)file.getData() + file.getSize();
+
+    gateIndex = 0;
+    controlMask = 0;
+    inversionMask = 0;
+}
+
+Scheme BinarySchemeReader::readAll()
+{
+    Scheme scheme;
+
+    ReverseElement element;
+    while (next(&element))
+        scheme.push_back(element);
+
+    return scheme;
+}
+
+word BinarySchemeReader::readVarint()
+{
+    word value = 0;
+    for (uint shift = 0; shift < sizeof(word) * 8; shift += 7)
+    {
+        if (current == end)
+            break;
+
+        uint8_t byte = *current++;
+        value |= (word)(byte & 0x7F) << shift;
+
+        if (!(byte & 0x80))
+            return value;
+    }
+
+    throwInvalidFormat();
+    return 0;
+}
+
+void BinarySchemeReader::throwInvalidFormat() const
+{
+    throw InvalidFormatException(string("Invalid binary scheme file \"") + fileName + "\"");
+}
+
+} //namespace ReversibleLogic
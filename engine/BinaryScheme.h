@@ -0,0 +1,127 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Compact binary scheme file (*.bscheme) for intermediate results.
+/// Layout of file: header, then one record for each gate:
+///   - 1 byte with target line index;
+///   - varint with control mask, xor-ed with control mask of previous gate;
+///   - varint with inversion mask, xor-ed with inversion mask of previous gate.
+/// Varint is little-endian base 128 number: 7 bits in each byte, high bit is set
+/// if more bytes follow. Neighbour gates usually share most of controls,
+/// so delta masks are small and most of gates take 3 bytes.
+struct BinarySchemeHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t lineCount;
+    uint32_t reserved;
+    uint64_t gateCount;
+};
+
+/// Buffered writer of binary scheme file
+class BinarySchemeWriter : public GateSink
+{
+public:
+    BinarySchemeWriter(const string& fileName, uint lineCount);
+    virtual ~BinarySchemeWriter();
+
+    virtual void writeElement(const ReverseElement& element);
+
+    /// Writes buffered gates and final gate count to the file
+    void close();
+
+private:
+    BinarySchemeWriter(const BinarySchemeWriter&) = delete;
+    BinarySchemeWriter& operator=(const BinarySchemeWriter&) = delete;
+
+    enum
+    {
+        numBufferSize = 1 << 20,
+
+        /// Maximum size of one gate record
+        numMaxRecordSize = 1 + 2 * 10,
+    };
+
+    void appendVarint(word value);
+    void flush();
+
+    ofstream output;
+    uint lineCount;
+    uint64_t gateCount = 0;
+
+    word lastControlMask = 0;
+    word lastInversionMask = 0;
+
+    vector<uint8_t> buffer;
+    uint bufferSize = 0;
+};
+
+/// Reader of binary scheme file: file is memory mapped and gates are decoded
+/// one by one on request, so huge schemes could be processed without loading
+class BinarySchemeReader
+{
+public:
+    BinarySchemeReader() = default;
+    virtual ~BinarySchemeReader() = default;
+
+    /// Returns true if @fileName has binary scheme extension
+    static bool isBinarySchemeFile(const string& fileName);
+    static const char* getFileExtension();
+
+    void open(const string& fileName);
+    bool isOpen() const;
+
+    uint getLineCount() const;
+    uint64_t getGateCount() const;
+
+    /// Decodes next gate to @element, returns false if all gates were read
+    bool next(ReverseElement* element);
+
+    /// Restarts reading from the first gate
+    void rewind();
+
+    /// Reads all remaining gates
+    Scheme readAll();
+
+private:
+    BinarySchemeReader(const BinarySchemeReader&) = delete;
+    BinarySchemeReader& operator=(const BinarySchemeReader&) = delete;
+
+    word readVarint();
+    void throwInvalidFormat() const;
+
+    MappedFile file;
+    string fileName;
+
+    const BinarySchemeHeader* header = 0;
+    const uint8_t* current = 0;
+    const uint8_t* end = 0;
+
+    uint64_t gateIndex = 0;
+    word controlMask = 0;
+    word inversionMask = 0;
+};
+
+} //namespace ReversibleLogic
@@ -0,0 +1,249 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+static const char strBinaryTruthTableMagic[4] = { 'R', 'L', 'T', 'T' };
+static const uint32_t numBinaryTruthTableVersion = 1;
+
+//static
+bool BinaryTruthTable::isBinaryTruthTableFile(const string& fileName)
+{
+    string extension = getFileExtension();
+    return fileName.size() > extension.size() &&
+        fileName.compare(fileName.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+//static
+const char* BinaryTruthTable::getFileExtension()
+{
+    return ".btable";
+}
+
+//static
+void BinaryTruthTable::write(const TruthTable& table, uint inputCount, uint outputCount,
+    const string& fileName)
+{
+    assert(inputCount < sizeof(word) * 8 && table.size() == ((word)1 << inputCount),
+        string("BinaryTruthTable::write(): wrong truth table size"));
+
+    uint entryWidth = getEntryWidth(outputCount);
+
+    // entries are little-endian, so they are packed byte by byte
+    vector<uint8_t> data(table.size() * entryWidth);
+    uint8_t* entry = data.data();
+
+    for (auto& value : table)
+    {
+        for (uint index = 0; index < entryWidth; ++index)
+            *entry++ = (uint8_t)(value >> (index * 8));
+    }
+
+    Header fileHeader;
+    memcpy(fileHeader.magic, strBinaryTruthTableMagic, sizeof(fileHeader.magic));
+    fileHeader.version = numBinaryTruthTableVersion;
+    fileHeader.inputCount = inputCount;
+    fileHeader.outputCount = outputCount;
+    fileHeader.entryWidth = entryWidth;
+    fileHeader.reserved = 0;
+    fileHeader.checksum = calculateChecksum(data.data(), data.size());
+
+    ofstream output(fileName, ios_base::out | ios_base::binary);
+    assert(output.is_open(),
+        string("Failed to open binary truth table file \"") + fileName + "\" for writing");
+
+    output.write((const char*)&fileHeader, sizeof(fileHeader));
+    output.write((const char*)data.data(), data.size());
+    output.close();
+}
+
+void BinaryTruthTable::load(const string& fileName)
+{
+    header = 0;
+    entries = 0;
+
+    assert(file.open(fileName),
+        string("Failed to open binary truth table file \"") + fileName + "\" for reading");
+
+    string error = string("Invalid binary truth table file \"") + fileName + "\"";
+    if (file.getSize() < sizeof(Header))
+        throw InvalidFormatException(move(error));
+
+    const Header* fileHeader = (const Header*)file.getData();
+    const uint8_t* fileEntries = (const uint8_t*)(fileHeader + 1);
+
+    uint inputCount = fileHeader->inputCount;
+    uint64_t entriesSize = 0;
+    if (inputCount < sizeof(word) * 8)
+        entriesSize = ((uint64_t)1 << inputCount) * fileHeader->entryWidth;
+
+    if (memcmp(fileHeader->magic, strBinaryTruthTableMagic, sizeof(fileHeader->magic)) ||
+        fileHeader->version != numBinaryTruthTableVersion ||
+        inputCount >= sizeof(word) * 8 ||
+        fileHeader->outputCount > inputCount ||
+        fileHeader->entryWidth != getEntryWidth(fileHeader->outputCount) ||
+        file.getSize() != sizeof(Header) + entriesSize ||
+        fileHeader->checksum != calculateChecksum(fileEntries, entriesSize))
+    {
+        file.close();
+        throw InvalidFormatException(move(error));
+    }
+
+    header = fileHeader;
+    entries = fileEntries;
+}
+
+bool BinaryTruthTable::isLoaded() const
+{
+    return header != 0;
+}
+
+uint BinaryTruthTable::getInputCount() const
+{
+    return (header ? header->inputCount : 0);
+}
+
+uint BinaryTruthTable::getOutputCount() const
+{
+    return (header ? header->outputCount : 0);
+}
+
+word BinaryTruthTable::getEntryCount() const
+{
+    return (header ? (word)1 << header->inputCount : 0);
+}
+
+word BinaryTruthTable::operator[](word x) const
+{
+    assertd(header, string("BinaryTruthTable: table is not loaded"));
+
+    word value = 0;
+    switch (header->entryWidth)
+    {
+    case 1:
+        value = entries[x];
+        break;
+
+    case 2:
+        value = entries[2 * x] | ((word)entries[2 * x + 1] << 8);
+        break;
+
+    default:
+        {
+            const uint8_t* entry = entries + x * header->entryWidth;
+            for (uint index = header->entryWidth; index > 0; --index)
+                value = (value << 8) | entry[index - 1];
+        }
+        break;
+    }
+
+    return value;
+}
+
+template<typename Entry>
+const Entry* BinaryTruthTable::getEntries() const
+{
+    assert(header, string("BinaryTruthTable: table is not loaded"));
+
+    // entries follow header of 32 bytes in mapped file, so they are aligned
+    const uint16_t probe = 1;
+    bool isLittleEndian = (*(const uint8_t*)&probe == 1);
+
+    if (header->entryWidth != sizeof(Entry) || !isLittleEndian)
+        return 0;
+
+    return (const Entry*)entries;
+}
+
+template<typename Entry>
+BasicTruthTable<Entry> BinaryTruthTable::toTruthTable() const
+{
+    assert(header, string("BinaryTruthTable: table is not loaded"));
+    assert(header->outputCount <= (uint)numeric_limits<Entry>::digits,
+        string("BinaryTruthTable::toTruthTable(): output values don't fit in entry"));
+
+    word count = getEntryCount();
+    word maxOutputValue = (word)1 << header->outputCount;
+
+    BasicTruthTable<Entry> table;
+
+    // entry width doesn't exceed sizeof(Entry), so values are never truncated
+    const Entry* mappedEntries = getEntries<Entry>();
+    if (mappedEntries)
+    {
+        table.assign(mappedEntries, mappedEntries + count);
+    }
+    else
+    {
+        table.resize((size_t)count);
+        for (word x = 0; x < count; ++x)
+            table[(size_t)x] = (Entry)(*this)[x];
+    }
+
+    for (word x = 0; x < count; ++x)
+    {
+        word y = table[(size_t)x];
+        if (y >= maxOutputValue)
+            throw InvalidFormatException(string("Invalid binary truth table entry: ") +
+                to_string(x) + " => " + to_string(y));
+    }
+
+    return table;
+}
+
+//static
+uint BinaryTruthTable::getEntryWidth(uint outputCount)
+{
+    uint entryWidth = 1;
+    while (entryWidth * 8 < outputCount)
+        entryWidth <<= 1;
+
+    return entryWidth;
+}
+
+//static
+uint64_t BinaryTruthTable::calculateChecksum(const uint8_t* data, uint64_t size)
+{
+    // FNV-1a
+    uint64_t checksum = 0xcbf29ce484222325ULL;
+    for (uint64_t index = 0; index < size; ++index)
+    {
+        checksum ^= data[index];
+        checksum *= 0x100000001b3ULL;
+    }
+
+    return checksum;
+}
+
+// packed truth tables, word is one of these types
+#define INSTANTIATE_BINARY_TRUTH_TABLE(Entry) \
+    template const Entry* BinaryTruthTable::getEntries() const; \
+    template BasicTruthTable<Entry> BinaryTruthTable::toTruthTable() const;
+
+INSTANTIATE_BINARY_TRUTH_TABLE(uint16_t)
+INSTANTIATE_BINARY_TRUTH_TABLE(uint32_t)
+INSTANTIATE_BINARY_TRUTH_TABLE(uint64_t)
+
+#undef INSTANTIATE_BINARY_TRUTH_TABLE
+
+} //namespace ReversibleLogic
@@ -0,0 +1,89 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Truth table in binary file (*.btable), which is loaded without parsing:
+/// file is memory mapped and entries are read right from it.
+/// Layout of file: header, then 2^n entries of entryWidth bytes (1, 2, 4 or 8),
+/// i-th entry is little-endian image of i.
+class BinaryTruthTable
+{
+public:
+    BinaryTruthTable() = default;
+    virtual ~BinaryTruthTable() = default;
+
+    /// Returns true if @fileName has binary truth table extension
+    static bool isBinaryTruthTableFile(const string& fileName);
+    static const char* getFileExtension();
+
+    /// Writes @table of function with @inputCount inputs and @outputCount outputs to @fileName
+    static void write(const TruthTable& table, uint inputCount, uint outputCount,
+        const string& fileName);
+
+    void load(const string& fileName);
+    bool isLoaded() const;
+
+    uint getInputCount() const;
+    uint getOutputCount() const;
+    word getEntryCount() const;
+
+    /// Returns image of @x, there is no range check
+    word operator[](word x) const;
+
+    /// Returns read-only view of mapped entries, if entry width is sizeof(@Entry)
+    /// (2, 4 or 8 bytes) and platform is little-endian, otherwise returns null
+    template<typename Entry>
+    const Entry* getEntries() const;
+
+    /// Copies entries to table, which could be passed to generators,
+    /// output values should fit in @Entry type.
+    /// Entries of the same width are copied from view without decoding and widening
+    template<typename Entry>
+    BasicTruthTable<Entry> toTruthTable() const;
+
+private:
+    BinaryTruthTable(const BinaryTruthTable&) = delete;
+    BinaryTruthTable& operator=(const BinaryTruthTable&) = delete;
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t inputCount;
+        uint32_t outputCount;
+        uint32_t entryWidth;
+        uint32_t reserved;
+        /// Checksum of entries, see calculateChecksum()
+        uint64_t checksum;
+    };
+
+    static uint getEntryWidth(uint outputCount);
+    static uint64_t calculateChecksum(const uint8_t* data, uint64_t size);
+
+    MappedFile file;
+    const Header* header = 0;
+    const uint8_t* entries = 0;
+};
+
+} //namespace ReversibleLogic
@@ -0,0 +1,79 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+class BitMatrixUtils
+{
+public:
+    /// Transposes bit matrix, given as @rows with @columnCount bits in each row
+    /// Returns @columnCount columns with rows.size() bits in each column
+    /// Source and destination types may be word, WideWord or DynamicWord
+    template<typename Dst, typename Src>
+    static vector<Dst> transpose(const vector<Src>& rows, uint columnCount);
+
+    /// In-place transpose of square block of numBitsInWord x numBitsInWord bits
+    /// Bit j of @block[i] is the element in i-th row and j-th column
+    static void transposeBlock(word* block);
+};
+
+template<typename Dst, typename Src>
+vector<Dst> BitMatrixUtils::transpose(const vector<Src>& rows, uint columnCount)
+{
+    uint rowCount = rows.size();
+
+    vector<Dst> columns;
+    columns.resize(columnCount, BitVectorTraits<Dst>::create(rowCount));
+
+    uint rowBlockCount = (rowCount + numBitsInWord - 1) / numBitsInWord;
+    uint columnBlockCount = (columnCount + numBitsInWord - 1) / numBitsInWord;
+
+    word block[numBitsInWord];
+    for (uint rowBlock = 0; rowBlock < rowBlockCount; ++rowBlock)
+    {
+        uint rowStart = rowBlock * numBitsInWord;
+        uint rowEnd = min(rowStart + numBitsInWord, rowCount);
+
+        for (uint columnBlock = 0; columnBlock < columnBlockCount; ++columnBlock)
+        {
+            uint columnStart = columnBlock * numBitsInWord;
+            uint columnEnd = min(columnStart + numBitsInWord, columnCount);
+
+            for (uint index = rowStart; index < rowEnd; ++index)
+                block[index - rowStart] = BitVectorTraits<Src>::getWord(rows[index], columnBlock);
+
+            for (uint index = rowEnd - rowStart; index < numBitsInWord; ++index)
+                block[index] = 0;
+
+            transposeBlock(block);
+
+            // bits of row beyond @columnCount are dropped here
+            for (uint index = columnStart; index < columnEnd; ++index)
+                BitVectorTraits<Dst>::setWord(&columns[index], rowBlock, block[index - columnStart]);
+        }
+    }
+
+    return columns;
+}
+
+} //namespace ReversibleLogic
@@ -0,0 +1,165 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+BitSlicedSimulator::BitSlicedSimulator(uint lineCount, uint inputCount)
+    : lineCount(lineCount)
+    , inputCount(inputCount)
+{
+    assert(inputCount <= lineCount && lineCount <= numBitsPerWord &&
+        inputCount < numBitsPerWord - numBitsPerWordLog,
+        string("BitSlicedSimulator(): wrong line count"));
+
+    simulatedCount = (word)1 << inputCount;
+
+    blockCount = 1;
+    if (inputCount > numBitsPerWordLog)
+        blockCount = (size_t)1 << (inputCount - numBitsPerWordLog);
+
+    state.resize(lineCount * blockCount);
+
+    // values of the first 6 input lines repeat in each word
+    static const word patterns[numBitsPerWordLog] =
+    {
+        0xAAAAAAAAAAAAAAAAULL,
+        0xCCCCCCCCCCCCCCCCULL,
+        0xF0F0F0F0F0F0F0F0ULL,
+        0xFF00FF00FF00FF00ULL,
+        0xFFFF0000FFFF0000ULL,
+        0xFFFFFFFF00000000ULL,
+    };
+
+    for (uint line = 0; line < inputCount; ++line)
+    {
+        word* lineState = &state[line * blockCount];
+        for (size_t block = 0; block < blockCount; ++block)
+        {
+            if (line < numBitsPerWordLog)
+                lineState[block] = patterns[line];
+            else if ((block >> (line - numBitsPerWordLog)) & 1)
+                lineState[block] = (word)-1;
+        }
+    }
+}
+
+BitSlicedSimulator::BitSlicedSimulator(uint lineCount, const vector<word>& inputs)
+    : lineCount(lineCount)
+    , simulatedCount(inputs.size())
+{
+    assert(lineCount <= numBitsPerWord, string("BitSlicedSimulator(): wrong line count"));
+
+    blockCount = (size_t)((simulatedCount + numBitsPerWord - 1) >> numBitsPerWordLog);
+    state.resize(lineCount * blockCount);
+
+    for (size_t index = 0; index < inputs.size(); ++index)
+    {
+        size_t block = index >> numBitsPerWordLog;
+        word bit = (word)1 << (index & (numBitsPerWord - 1));
+
+        word x = inputs[index];
+        for (uint line = 0; x && line < lineCount; ++line, x >>= 1)
+        {
+            if (x & 1)
+                state[line * blockCount + block] |= bit;
+        }
+    }
+}
+
+void BitSlicedSimulator::writeElement(const ReverseElement& element)
+{
+    assert(element.isIndependent(),
+        string("BitSlicedSimulator::writeElement(): dependent elements are not supported"));
+
+    uint target = findPositiveBitPosition(element.getTargetMask());
+    assert(target < lineCount && element.getControlMask() <= getFullMask(lineCount),
+        string("BitSlicedSimulator::writeElement(): wrong element"));
+
+    const word* controls[numBitsPerWord];
+    word inversions[numBitsPerWord];
+    uint controlCount = 0;
+
+    word controlMask = element.getControlMask();
+    word inversionMask = element.getInversionMask();
+
+    for (uint line = 0; controlMask; ++line, controlMask >>= 1, inversionMask >>= 1)
+    {
+        if (controlMask & 1)
+        {
+            controls[controlCount] = &state[line * blockCount];
+            inversions[controlCount] = (inversionMask & 1 ? (word)-1 : 0);
+            ++controlCount;
+        }
+    }
+
+    word* targetState = &state[target * blockCount];
+    for (size_t block = 0; block < blockCount; ++block)
+    {
+        word value = (word)-1;
+        for (uint index = 0; index < controlCount; ++index)
+            value &= controls[index][block] ^ inversions[index];
+
+        targetState[block] ^= value;
+    }
+}
+
+word BitSlicedSimulator::getOutput(word index) const
+{
+    assertd(index < simulatedCount, string("BitSlicedSimulator::getOutput(): wrong input"));
+
+    size_t block = (size_t)(index >> numBitsPerWordLog);
+    uint shift = (uint)(index & (numBitsPerWord - 1));
+
+    word output = 0;
+    for (uint line = 0; line < lineCount; ++line)
+        output |= ((state[line * blockCount + block] >> shift) & 1) << line;
+
+    return output;
+}
+
+template<typename Entry>
+bool BitSlicedSimulator::checkOutputs(const BasicTruthTable<Entry>& table,
+    uint firstOutputLine, uint outputCount) const
+{
+    assert(table.size() == simulatedCount &&
+        firstOutputLine + outputCount <= lineCount,
+        string("BitSlicedSimulator::checkOutputs(): wrong truth table"));
+
+    word mask = getFullMask(outputCount);
+
+    size_t size = table.size();
+    for (size_t x = 0; x < size; ++x)
+    {
+        if (((getOutput(x) >> firstOutputLine) & mask) != table[x])
+            return false;
+    }
+
+    return true;
+}
+
+// packed truth tables, word is one of these types
+template bool BitSlicedSimulator::checkOutputs(const BasicTruthTable<uint16_t>&, uint, uint) const;
+template bool BitSlicedSimulator::checkOutputs(const BasicTruthTable<uint32_t>&, uint, uint) const;
+template bool BitSlicedSimulator::checkOutputs(const BasicTruthTable<uint64_t>&, uint, uint) const;
+
+} //namespace ReversibleLogic
@@ -0,0 +1,74 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Simulator of scheme on all inputs at once. State of each line is a bit vector
+/// over all inputs (bit x of the vector is value of the line for input x),
+/// so element is applied to 64 inputs with one word operation per control.
+/// Elements are applied as they come, the scheme itself is not stored.
+class BitSlicedSimulator : public GateSink
+{
+public:
+    /// @lineCount - number of scheme lines, first @inputCount lines get input values,
+    /// other lines are initialized with zeros
+    BitSlicedSimulator(uint lineCount, uint inputCount);
+
+    /// Simulation on @inputs only, each input contains initial values of all lines
+    BitSlicedSimulator(uint lineCount, const vector<word>& inputs);
+
+    virtual ~BitSlicedSimulator() = default;
+
+    virtual void writeElement(const ReverseElement& element);
+
+    /// Returns values of all lines for input with @index,
+    /// input x has index x for simulation on all inputs
+    word getOutput(word index) const;
+
+    /// Returns true if values of @outputCount lines starting from @firstOutputLine
+    /// are equal to @table for all inputs (for simulation on all inputs)
+    template<typename Entry>
+    bool checkOutputs(const BasicTruthTable<Entry>& table,
+        uint firstOutputLine, uint outputCount) const;
+
+private:
+    enum
+    {
+        numBitsPerWord = sizeof(word) * 8,
+        numBitsPerWordLog = 6,
+    };
+
+    uint lineCount;
+    uint inputCount = 0;
+
+    /// Number of simulated inputs
+    word simulatedCount;
+
+    /// Number of words in state vector of one line
+    size_t blockCount;
+
+    /// State vectors of all lines, one after another
+    vector<word> state;
+};
+
+} //namespace ReversibleLogic
@@ -77,14 +77,14 @@ bool BooleanEdge::has(word x) const
 // class BooleanEdgeSearcher
 
 BooleanEdgeSearcher::BooleanEdgeSearcher(
-    shared_ptr<list<ReversibleLogic::Transposition>> input,
+    const ReversibleLogic::TranspositionSpan& input,
     uint n, word initialMask)
     : inputSet()
     , n(n)
     , initialMask(initialMask)
     , frequencyTable()
 {
-    for (auto& transp : *input)
+    for (auto& transp : input)
     {
         inputSet.insert(transp.getX());
         inputSet.insert(transp.getY());
@@ -248,28 +248,33 @@ bool BooleanEdgeSearcher::checkEdge(BooleanEdge* edge)
 }
 
 // static
-shared_ptr<list<ReversibleLogic::Transposition>> BooleanEdgeSearcher::filterTranspositionsByEdge(BooleanEdge edge, uint n,
-    shared_ptr<list<ReversibleLogic::Transposition>> transpositions)
+ReversibleLogic::TranspositionSpan BooleanEdgeSearcher::filterTranspositionsByEdge(BooleanEdge edge, uint n,
+    const ReversibleLogic::TranspositionSpan& transpositions, ReversibleLogic::TranspositionArena* arena)
 {
     using namespace ReversibleLogic;
 
     word baseValue = edge.getBaseValue();
     word baseMask  = edge.getBaseMask();
 
-    shared_ptr<list<Transposition>> filteredResult(new list<Transposition>);
-    for (auto& transp : *transpositions)
+    // @transpositions may be stored in @arena too, so copy them by index
+    uint position = arena->getPosition();
+
+    uint count = transpositions.size();
+    for (uint index = 0; index < count; ++index)
     {
+        Transposition transp = transpositions[index];
         word x = transp.getX();
 
         word value = x & baseMask;
         if(value == baseValue)
-            filteredResult->push_back(transp);
+            arena->push(transp);
     }
 
-    return filteredResult;
+    return arena->makeSpan(position);
 }
 
-shared_ptr<list<ReversibleLogic::Transposition>> BooleanEdgeSearcher::getEdgeSubset(BooleanEdge edge, uint n)
+ReversibleLogic::TranspositionSpan BooleanEdgeSearcher::getEdgeSubset(BooleanEdge edge, uint n,
+    ReversibleLogic::TranspositionArena* arena)
 {
     using namespace ReversibleLogic;
 
@@ -291,7 +296,7 @@ shared_ptr<list<ReversibleLogic::Transposition>> BooleanEdgeSearcher::getEdgeSub
     unordered_set<word> visitedElements;
     word baseValue = edge.getBaseValue();
 
-    shared_ptr<list<Transposition>> subset(new list<Transposition>);
+    uint position = arena->getPosition();
     for(word index = 0; index < totalCount; ++index)
     {
         word x = baseValue;
@@ -304,14 +309,14 @@ shared_ptr<list<ReversibleLogic::Transposition>> BooleanEdgeSearcher::getEdgeSub
         word y = x ^ initialMask;
         if(visitedElements.find(x) == visitedElements.cend())
         {
-            subset->push_back(Transposition(x, y));
+            arena->push(x, y);
 
             visitedElements.insert(x);
             visitedElements.insert(y);
         }
     }
 
-    return subset;
+    return arena->makeSpan(position);
 }
 
 shared_ptr<unordered_set<word>> BooleanEdgeSearcher::getEdgeSet(BooleanEdge edge)
@@ -52,7 +52,7 @@ struct BooleanEdge
 class BooleanEdgeSearcher
 {
 public:
-    explicit BooleanEdgeSearcher(shared_ptr<list<ReversibleLogic::Transposition>> input,
+    explicit BooleanEdgeSearcher(const ReversibleLogic::TranspositionSpan& input,
         uint n, word initialMask);
 
     explicit BooleanEdgeSearcher(const unordered_set<word>& inputs, uint n);
@@ -63,10 +63,13 @@ public:
 
     BooleanEdge findEdge();
 
-    static shared_ptr<list<ReversibleLogic::Transposition>> filterTranspositionsByEdge(BooleanEdge edge, uint n,
-        shared_ptr<list<ReversibleLogic::Transposition>> transpositions);
+    /// Result is allocated in @arena
+    static ReversibleLogic::TranspositionSpan filterTranspositionsByEdge(BooleanEdge edge, uint n,
+        const ReversibleLogic::TranspositionSpan& transpositions, ReversibleLogic::TranspositionArena* arena);
 
-    shared_ptr<list<ReversibleLogic::Transposition>> getEdgeSubset(BooleanEdge edge, uint n);
+    /// Result is allocated in @arena
+    ReversibleLogic::TranspositionSpan getEdgeSubset(BooleanEdge edge, uint n,
+        ReversibleLogic::TranspositionArena* arena);
 
     shared_ptr<unordered_set<word>> getEdgeSet(BooleanEdge edge);
 
@@ -0,0 +1,219 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+void CommutationDag::build(const vector<ReverseElement>& scheme, uint theMaxDistance)
+{
+    assertd(theMaxDistance, string("CommutationDag: zero max distance"));
+
+    maxDistance = theMaxDistance;
+    wordCount = (maxDistance + numBitsInWord - 1) / numBitsInWord;
+    elementCount = 0;
+
+    leftBlockers.clear();
+    rightBlockers.clear();
+    rightSameTargets.clear();
+
+    update(scheme, 0, 0, scheme.size());
+}
+
+void CommutationDag::update(const vector<ReverseElement>& scheme, uint first,
+    uint removedCount, uint insertedCount)
+{
+    assertd(first + removedCount <= elementCount && scheme.size() == elementCount - removedCount + insertedCount,
+        string("CommutationDag: wrong update range"));
+
+    vector<word>* allMasks[] = { &leftBlockers, &rightBlockers, &rightSameTargets };
+    for (vector<word>* masks : allMasks)
+    {
+        vector<word>::iterator position = masks->begin() + first * wordCount;
+        if (removedCount > insertedCount)
+            masks->erase(position, position + (removedCount - insertedCount) * wordCount);
+        else if (removedCount < insertedCount)
+            masks->insert(position, (insertedCount - removedCount) * wordCount, 0);
+    }
+
+    elementCount = scheme.size();
+    updateRange(scheme, first, first + insertedCount);
+}
+
+void CommutationDag::updateRange(const vector<ReverseElement>& scheme, uint first, uint last)
+{
+    // Edges inside of [first, last) range and edges, which cross it or end in it, are changed.
+    // Each of them is checked once and is stored in masks of both elements.
+    uint leftmost = (first > maxDistance ? first - maxDistance : 0);
+    uint rightmost = min(last + maxDistance, elementCount);
+
+    for (uint index = leftmost; index < rightmost; ++index)
+    {
+        if (index < last)
+        {
+            uint fromOffset = (index < first ? first - index : 1);
+            clearBits(getMask(rightBlockers, index), fromOffset);
+            clearBits(getMask(rightSameTargets, index), fromOffset);
+        }
+
+        if (index >= first)
+        {
+            uint fromOffset = (index < last ? 1 : index - last + 1);
+            clearBits(getMask(leftBlockers, index), fromOffset);
+        }
+    }
+
+    uint lastLeftIndex = min(last, elementCount - 1);
+    for (uint index = leftmost; index < lastLeftIndex; ++index)
+    {
+        const ReverseElement& element = scheme[index];
+        word targetMask = element.getTargetMask();
+
+        word* blockers = getMask(rightBlockers, index);
+        word* sameTargets = getMask(rightSameTargets, index);
+
+        uint fromOffset = (index < first ? first - index : 1);
+        uint toOffset = min(maxDistance, elementCount - 1 - index);
+
+        for (uint offset = fromOffset; offset <= toOffset; ++offset)
+        {
+            const ReverseElement& another = scheme[index + offset];
+
+            if (!element.isSwappable(another))
+            {
+                setBit(blockers, offset);
+                setBit(getMask(leftBlockers, index + offset), offset);
+            }
+
+            if (another.getTargetMask() == targetMask)
+                setBit(sameTargets, offset);
+        }
+    }
+}
+
+uint CommutationDag::getMaximumTransferIndex(uint startIndex, uint stopIndex) const
+{
+    assertd(startIndex < elementCount && stopIndex < elementCount && startIndex != stopIndex,
+        string("CommutationDag: wrong indices for getMaximumTransferIndex()"));
+
+    uint index = uintUndefined;
+    if (startIndex < stopIndex)
+    {
+        // from left to right
+        uint offset = findFirstOffset(getMask(rightBlockers, startIndex));
+        if (offset != uintUndefined && startIndex + offset < stopIndex)
+            index = startIndex + offset - 1;
+        else
+            index = min(stopIndex - 1, startIndex + maxDistance);
+    }
+    else
+    {
+        // from right to left
+        uint offset = findFirstOffset(getMask(leftBlockers, startIndex));
+        if (offset != uintUndefined && startIndex - offset > stopIndex)
+            index = startIndex - offset + 1;
+        else
+            index = max(stopIndex + 1, startIndex - min(startIndex, maxDistance));
+    }
+
+    return index;
+}
+
+void CommutationDag::getNonCommutingSuccessors(uint index, vector<uint>* indices) const
+{
+    getSuccessors(rightBlockers, index, indices);
+}
+
+void CommutationDag::getSameTargetSuccessors(uint index, vector<uint>* indices) const
+{
+    getSuccessors(rightSameTargets, index, indices);
+}
+
+uint CommutationDag::getMaxDistance() const
+{
+    return maxDistance;
+}
+
+void CommutationDag::getSuccessors(const vector<word>& masks, uint index, vector<uint>* indices) const
+{
+    assertd(indices && index < elementCount, string("CommutationDag: wrong index"));
+    indices->clear();
+
+    const word* mask = getMask(masks, index);
+    for (uint wordIndex = 0; wordIndex < wordCount; ++wordIndex)
+    {
+        uint offset = wordIndex * numBitsInWord + 1;
+        for (word bits = mask[wordIndex]; bits; bits >>= 1, ++offset)
+        {
+            if (bits & 1)
+                indices->push_back(index + offset);
+        }
+    }
+}
+
+word* CommutationDag::getMask(vector<word>& masks, uint index)
+{
+    return masks.data() + index * wordCount;
+}
+
+const word* CommutationDag::getMask(const vector<word>& masks, uint index) const
+{
+    return masks.data() + index * wordCount;
+}
+
+bool CommutationDag::hasBit(const word* mask, uint offset) const
+{
+    --offset;
+    return (mask[offset / numBitsInWord] >> (offset % numBitsInWord)) & 1;
+}
+
+void CommutationDag::setBit(word* mask, uint offset)
+{
+    --offset;
+    mask[offset / numBitsInWord] |= (word)1 << (offset % numBitsInWord);
+}
+
+void CommutationDag::clearBits(word* mask, uint fromOffset)
+{
+    --fromOffset;
+    for (uint wordIndex = fromOffset / numBitsInWord; wordIndex < wordCount; ++wordIndex)
+    {
+        uint bitIndex = wordIndex * numBitsInWord;
+        if (bitIndex >= fromOffset)
+            mask[wordIndex] = 0;
+        else
+            mask[wordIndex] &= ((word)1 << (fromOffset - bitIndex)) - 1;
+    }
+}
+
+uint CommutationDag::findFirstOffset(const word* mask) const
+{
+    for (uint wordIndex = 0; wordIndex < wordCount; ++wordIndex)
+    {
+        word bits = mask[wordIndex];
+        if (bits)
+            return wordIndex * numBitsInWord + findPositiveBitPosition(bits) + 1;
+    }
+
+    return uintUndefined;
+}
+
+}   // namespace ReversibleLogic
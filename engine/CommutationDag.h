@@ -0,0 +1,85 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Commutation DAG over scheme elements: there is an edge between two elements,
+/// if they are not swappable, i.e. some line is a target line of one of them
+/// and a control line of another one. Only edges not longer than max distance
+/// are stored as bit masks of relative offsets, so masks of elements stay valid,
+/// when another elements are inserted or removed far away from them.
+class CommutationDag
+{
+public:
+    CommutationDag() = default;
+    virtual ~CommutationDag() = default;
+
+    void build(const vector<ReverseElement>& scheme, uint theMaxDistance);
+
+    /// Updates DAG after elements in [first, first + removedCount) range of @scheme
+    /// were replaced by @insertedCount elements, @scheme should be already modified
+    void update(const vector<ReverseElement>& scheme, uint first, uint removedCount, uint insertedCount);
+
+    /// Returns index, to which element on @startIndex position could be moved in
+    /// direction of @stopIndex, element never reaches @stopIndex position itself.
+    /// Search is limited by max distance.
+    uint getMaximumTransferIndex(uint startIndex, uint stopIndex) const;
+
+    /// Fills @indices with ascending indices of elements to the right of @index
+    /// not farther than max distance, which are not swappable with element on @index
+    void getNonCommutingSuccessors(uint index, vector<uint>* indices) const;
+
+    /// Same as above for elements with the same target line
+    void getSameTargetSuccessors(uint index, vector<uint>* indices) const;
+
+    uint getMaxDistance() const;
+
+private:
+    /// Recalculates all edges, which are connected with elements in [first, last) range
+    void updateRange(const vector<ReverseElement>& scheme, uint first, uint last);
+
+    word* getMask(vector<word>& masks, uint index);
+    const word* getMask(const vector<word>& masks, uint index) const;
+
+    bool hasBit(const word* mask, uint offset) const;
+    void setBit(word* mask, uint offset);
+
+    /// Clears bits for all offsets starting from @fromOffset
+    void clearBits(word* mask, uint fromOffset);
+
+    /// Returns the least offset in @mask or uintUndefined if mask is empty
+    uint findFirstOffset(const word* mask) const;
+
+    void getSuccessors(const vector<word>& masks, uint index, vector<uint>* indices) const;
+
+    uint maxDistance = 0;
+    uint wordCount = 0; //words in one mask
+    uint elementCount = 0;
+
+    // bit (offset - 1) in mask of element is set, if it is connected with element on that offset
+    vector<word> leftBlockers;
+    vector<word> rightBlockers;
+    vector<word> rightSameTargets;
+};
+
+}   // namespace ReversibleLogic
@@ -23,7 +23,55 @@
 namespace ReversibleLogic
 {
 
-Scheme CompositeGenerator::generate(const TruthTable& table, ostream& outputLog)
+template<typename Entry>
+Scheme CompositeGenerator::generate(const BasicTruthTable<Entry>& table, ostream& outputLog)
+{
+    SchemeSink sink;
+    generate(table, &sink, outputLog);
+
+    return move(sink.getScheme());
+}
+
+template<typename Entry>
+void CompositeGenerator::generate(const BasicTruthTable<Entry>& table, GateSink* sink,
+    ostream& outputLog)
+{
+    assertd(sink, string("Null pointer (CompositeGenerator::generate)"));
+
+    Scheme scheme = synthesize(table, outputLog);
+
+    uint n = (uint)(log(table.size()) / log(2));
+    BitSlicedSimulator simulator(n, n);
+
+    SplitterSink splitter;
+    splitter.addSink(sink);
+    splitter.addSink(&simulator);
+
+    splitter.writeElements(scheme);
+
+    bool isValid = simulator.checkOutputs(table, 0, n);
+    assert(isValid, string("Generated scheme is not valid"));
+}
+
+template<typename Entry>
+Scheme CompositeGenerator::synthesize(const BasicTruthTable<Entry>& table, ostream& outputLog)
+{
+    // RM generator passes through the whole table many times, so narrow entries
+    // reduce memory traffic; table could be loaded with wider entries than needed,
+    // if it wasn't extended by ancillary inputs
+    uint n = (uint)(log(table.size()) / log(2));
+    uint entrySize = TruthTableUtils::getPackedEntrySize(n);
+    if (entrySize >= sizeof(Entry))
+        return synthesizePacked(table, outputLog);
+
+    if (entrySize == sizeof(uint16_t))
+        return synthesizePacked(TruthTableUtils::packTruthTable<uint16_t>(table), outputLog);
+
+    return synthesizePacked(TruthTableUtils::packTruthTable<uint32_t>(table), outputLog);
+}
+
+template<typename Entry>
+Scheme CompositeGenerator::synthesizePacked(const BasicTruthTable<Entry>& table, ostream& outputLog)
 {
     float totalTime = 0;
     float time = 0;
@@ -36,8 +84,8 @@ Scheme CompositeGenerator::generate(const TruthTable& table, ostream& outputLog)
     uint threshold = getRmGeneratorWeightThreshold(n);
     outputLog << "RM generator index weight threshold: " << threshold << endl;
 
-    RmGenerator rmGenerator(threshold);
-    RmGenerator::SynthesisResult rmResult;
+    BasicRmGenerator<Entry> rmGenerator(threshold);
+    typename BasicRmGenerator<Entry>::SynthesisResult rmResult;
 
     {
         AutoTimer timer(&time);
@@ -64,13 +112,18 @@ Scheme CompositeGenerator::generate(const TruthTable& table, ostream& outputLog)
 
     outputLog << "GT generator time: ";
     logTime(outputLog, time);
+
+    uint beamWidth = ProgramOptions::get().gtBeamWidth;
+    if (beamWidth > 1)
+        outputLog << "GT beam width: " << beamWidth << endl;
+
     outputLog << "GT left scheme complexity: " << gtLeftScheme.size() << endl;
     outputLog << "GT right scheme complexity: " << gtRightScheme.size() << endl;
 
     // combine GT and RM schemes
     Scheme& scheme = rmResult.scheme;
 
-    RmGenerator::PushPolicy pushPolicy = rmGenerator.getPushPolicy();
+    typename BasicRmGenerator<Entry>::PushPolicy pushPolicy = rmGenerator.getPushPolicy();
     if (pushPolicy.defaultPolicy)
     {
         if (gtLeftScheme.size() < gtRightScheme.size())
@@ -87,6 +140,8 @@ Scheme CompositeGenerator::generate(const TruthTable& table, ostream& outputLog)
     outputLog << "Complexity before optimization: " << scheme.size() << endl;
     outputLog << "Quantum cost before optimization: ";
     outputLog << SchemeUtils::calculateQuantumCost(scheme) << endl;
+    outputLog << "Depth before optimization: ";
+    outputLog << SchemeUtils::calculateDepth(scheme) << endl;
 
     // optimize scheme complexity
     PostProcessor postProcessor;
@@ -97,15 +152,17 @@ Scheme CompositeGenerator::generate(const TruthTable& table, ostream& outputLog)
     }
     totalTime += time;
 
-    bool isValid = TruthTableUtils::checkSchemeAgainstPermutationVector(scheme, table);
-    assert(isValid, string("Generated scheme is not valid"));
-
     // log post processing parameters
     outputLog << "Optimization time: ";
     logTime(outputLog, time);
     outputLog << "Complexity after optimization: " << scheme.size() << endl;
     outputLog << "Quantum cost after optimization: ";
     outputLog << SchemeUtils::calculateQuantumCost(scheme) << endl;
+    outputLog << "Depth after optimization: ";
+    outputLog << SchemeUtils::calculateDepth(scheme) << endl;
+
+    if (ProgramOptions::get().postProcessingTimeLimit)
+        postProcessor.logReport(outputLog);
 
     outputLog << "Total time: ";
     logTime(outputLog, totalTime);
@@ -135,4 +192,15 @@ uint CompositeGenerator::getRmGeneratorWeightThreshold(uint n)
     return threshold;
 }
 
+// packed truth tables, word is one of these types
+#define INSTANTIATE_COMPOSITE_GENERATOR(Entry) \
+    template Scheme CompositeGenerator::generate(const BasicTruthTable<Entry>&, ostream&); \
+    template void CompositeGenerator::generate(const BasicTruthTable<Entry>&, GateSink*, ostream&);
+
+INSTANTIATE_COMPOSITE_GENERATOR(uint16_t)
+INSTANTIATE_COMPOSITE_GENERATOR(uint32_t)
+INSTANTIATE_COMPOSITE_GENERATOR(uint64_t)
+
+#undef INSTANTIATE_COMPOSITE_GENERATOR
+
 } //namespace ReversibleLogic
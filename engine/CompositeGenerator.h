@@ -29,9 +29,24 @@ public:
     CompositeGenerator() = default;
     virtual ~CompositeGenerator() = default;
 
-    Scheme generate(const TruthTable& table, ostream& outputLog);
+    /// Truth tables are loaded with entries of any unsigned integer type
+    /// (see TruthTableUtils::getPackedEntrySize()), so wide table is never built
+    template<typename Entry>
+    Scheme generate(const BasicTruthTable<Entry>& table, ostream& outputLog);
+
+    /// Emits generated scheme to @sink, scheme is validated on the fly by simulator
+    template<typename Entry>
+    void generate(const BasicTruthTable<Entry>& table, GateSink* sink, ostream& outputLog);
 
 private:
+    /// Whole scheme is needed for post processing, so it is emitted only at the end
+    template<typename Entry>
+    Scheme synthesize(const BasicTruthTable<Entry>& table, ostream& outputLog);
+
+    /// Synthesis of @table packed to the narrowest entry type
+    template<typename Entry>
+    Scheme synthesizePacked(const BasicTruthTable<Entry>& table, ostream& outputLog);
+
     uint getRmGeneratorWeightThreshold(uint n);
     void logTime(ostream& out, float time);
 };
@@ -174,10 +174,10 @@ word Cycle::getOutput(word input) const
     return output;
 }
 
-word Cycle::getOutput(word input, shared_ptr<list<Transposition>> transpositions) const
+word Cycle::getOutput(word input, const TranspositionSpan& transpositions) const
 {
     word output = input;
-    for (auto& transp : *transpositions)
+    for (auto& transp : transpositions)
         output = transp.getOutput(output);
 
     return output;
@@ -199,7 +199,7 @@ uint Cycle::modIndex(uint index, uint mod) const
     return resIndex;
 }
 
-void Cycle::multiplyByTranspositions(shared_ptr<list<Transposition>> transpositions,
+void Cycle::multiplyByTranspositions(const TranspositionSpan& transpositions,
     bool isLeftMultiplication, vector<shared_ptr<Cycle>>* output) const
 {
     unordered_set<word> visitedElements;
@@ -274,13 +274,13 @@ void Cycle::prepareForDisjoint(unordered_map<word, uint>* frequencyMap)
     }
 }
 
-void Cycle::disjointByDiff(word diff, shared_ptr<list<Transposition>> result) const
+void Cycle::disjointByDiff(word diff, TranspositionArena* result) const
 {
     getTranspositionsByDiff(elements, diff, result);
 }
 
 void Cycle::getTranspositionsByDiff(const vector<word>& input, word diff,
-    shared_ptr<list<Transposition>> result) const
+    TranspositionArena* result) const
 {
     unordered_map<word, uint> elementToIndexMap;
     unordered_set<word> elementStorage;
@@ -359,13 +359,13 @@ void Cycle::getTranspositionsByDiff(const vector<word>& input, word diff,
         const word& x = input[bestLeftIndex];
         word y = x ^ diff;
 
-        result->push_back(Transposition(x, y));
+        result->push(x, y);
         getTranspositionsByDiff(input, diff, bestLeftIndex, bestRightIndex, result);
     }
 }
 
 void Cycle::getTranspositionsByDiff(const vector<word>& input, word diff,
-    uint xIndex, uint yIndex, shared_ptr<list<Transposition>> result) const
+    uint xIndex, uint yIndex, TranspositionArena* result) const
 {
     uint distance = yIndex - xIndex;
 
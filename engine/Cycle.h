@@ -60,10 +60,10 @@ public:
 
     /// Finds all possible transpositions from cycle which have specified Hamming distance
     /// @diff - Hamming distance which should have all returned transpositions
-    /// @result - output list for adding found transpositions
-    void disjointByDiff(word diff, shared_ptr<list<Transposition>> result) const;
+    /// @result - arena for adding found transpositions
+    void disjointByDiff(word diff, TranspositionArena* result) const;
 
-    void multiplyByTranspositions(shared_ptr<list<Transposition>> transpositions,
+    void multiplyByTranspositions(const TranspositionSpan& transpositions,
         bool isLeftMultiplication, vector<shared_ptr<Cycle>>* output) const;
 
     uint getDistancesSum() const;
@@ -74,15 +74,15 @@ private:
     uint modIndex(uint index, uint mod) const;
 
     /// Returns f_n(f_{n-1}(...(f_1(input))...)), where f_i is defined by i-th transposition in @transpositions
-    word getOutput(word input, shared_ptr<list<Transposition>> transpositions) const;
+    word getOutput(word input, const TranspositionSpan& transpositions) const;
 
     /// Gets all possible transpositions with specified Hamming distance @diff
     /// from vector of elements @input and puts them to @result
     void getTranspositionsByDiff(const vector<word>& input, word diff,
-        shared_ptr<list<Transposition>> result) const;
+        TranspositionArena* result) const;
 
     void getTranspositionsByDiff(const vector<word>& input, word diff,
-        uint xIndex, uint yIndex, shared_ptr<list<Transposition>> result) const;
+        uint xIndex, uint yIndex, TranspositionArena* result) const;
 
     vector<word> elements;
     bool finalized;
@@ -120,14 +120,14 @@ bool ReverseElement::isValid() const
     bool valid = true;
 
     uint targetCount = countNonZeroBits(targetMask);
-    word maxValue = 1 << n;
+    word fullMask = getFullMask(n);
 
     if (targetCount != 1
         || (targetMask & controlMask)
         || (targetMask & inversionMask)
-        || targetMask > maxValue
-        || controlMask > maxValue
-        || inversionMask > maxValue)
+        || (targetMask & ~fullMask)
+        || (controlMask & ~fullMask)
+        || (inversionMask & ~fullMask))
     {
         valid = false;
     }
@@ -271,7 +271,7 @@ word ReverseElement::getValue(word input) const
             output ^= targetMask;
         else
         {
-            word full = (1 << n) - 1;
+            word full = getFullMask(n);
             word freeMask = full ^ targetMask ^ controlMask;
             if(output == full)                      // 1111 -> 1101
                 output ^= freeMask;
@@ -370,11 +370,11 @@ deque<ReverseElement> ReverseElement::getInversionOptimizedImplementation(bool h
 
 word ReverseElement::getFreeInputMask() const
 {
-    word freeInputMask = (((word)1 << n) - 1 ) & ~(targetMask | controlMask);
+    word freeInputMask = getFullMask(n) & ~(targetMask | controlMask);
     uint freeInputPos = findPositiveBitPosition(freeInputMask);
     assertd(freeInputPos != uintUndefined, string("Free input not found"));
 
-    freeInputMask = (uint)1 << freeInputPos;
+    freeInputMask = (word)1 << freeInputPos;
     return freeInputMask;
 }
 
@@ -388,9 +388,9 @@ deque<ReverseElement> ReverseElement::getSimpleImplementation() const
 
     // conjugate core implementation by inversions
     deque<ReverseElement> inversions;
-    uint mask = 1;
+    word mask = 1;
     
-    while(mask <= inversionMask)
+    while(mask && mask <= inversionMask)
     {
         if(inversionMask & mask)
             inversions.push_back(ReverseElement(n, mask));
@@ -413,7 +413,7 @@ deque<ReverseElement> ReverseElement::getRecursiveImplementation() const
     if (inversionMask)
     {
         uint pos = findPositiveBitPosition(inversionMask);
-        word mask = 1 << pos;
+        word mask = (word)1 << pos;
 
         word reducedMask = inversionMask ^ mask;
         ReverseElement first(n, targetMask, controlMask, reducedMask);
@@ -449,7 +449,7 @@ ReverseElement::getLeftmostElement(bool heavyRight /* = true */) const
 {
     uint firstControlPos = findPositiveBitPosition(controlMask);
     assertd(firstControlPos != uintUndefined, string("First control not found"));
-    word firstControlMask = 1 << firstControlPos;
+    word firstControlMask = (word)1 << firstControlPos;
 
     // we need one free input for implementation
     word freeInputMask = getFreeInputMask();
@@ -487,7 +487,7 @@ ReverseElement::getRightmostElement(bool heavyRight /* = true */) const
 {
     uint firstControlPos = findPositiveBitPosition(controlMask);
     assertd(firstControlPos != uintUndefined, string("First control not found"));
-    word firstControlMask = 1 << firstControlPos;
+    word firstControlMask = (word)1 << firstControlPos;
 
     // we need one free input for implementation
     word freeInputMask = getFreeInputMask();
@@ -29,7 +29,9 @@ public:
     ReverseElement();
     explicit ReverseElement( uint n, word targetMask, word controlMask = 0, word inversionMask = 0);
 
-    virtual ~ReverseElement() = default;
+    /// Not virtual: schemes could hold millions of elements, vtable pointer
+    /// would take a fifth of element size
+    ~ReverseElement() = default;
 
     void setInputCount(uint count);
     uint getInputCount() const;
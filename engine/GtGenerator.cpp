@@ -23,7 +23,8 @@
 namespace ReversibleLogic
 {
 
-Scheme GtGenerator::generate(const TruthTable& table)
+template<typename Entry>
+Scheme GtGenerator::generate(const BasicTruthTable<Entry>& table)
 {
     n = 0;
 
@@ -51,21 +52,252 @@ Scheme GtGenerator::generate(const TruthTable& table)
     Scheme scheme;
     if (permutation.length())
     {
+        generatorOptions = PartialGtGenerator::Options::load();
+        spareGenerators.clear();
+
+        uint beamWidth = ProgramOptions::get().gtBeamWidth;
+        if (beamWidth > 1)
+            return generateWithBeamSearch(beamWidth);
+
         Scheme::iterator targetIter = scheme.end();
 
-        shared_ptr<PartialGtGenerator> partialGenerator(new PartialGtGenerator());
+        arenas[0].reset();
+
+        shared_ptr<PartialGtGenerator> partialGenerator = acquireGenerator(&arenas[0]);
         partialGenerator->setPermutation(permutation, n);
         partialGenerator->prepareForGeneration();
 
-        while (partialGenerator)
-            partialGenerator = reducePermutation(partialGenerator, n, &scheme, &targetIter);
+        reduceGreedily(partialGenerator, &scheme, &targetIter);
     }
 
     return scheme;
 }
 
+void GtGenerator::reduceGreedily(shared_ptr<PartialGtGenerator> partialGenerator,
+    Scheme* scheme, Scheme::iterator* targetIter)
+{
+    uint arenaIndex = 0;
+    while (partialGenerator)
+    {
+        arenaIndex ^= 1;
+        arenas[arenaIndex].reset();
+
+        partialGenerator = reducePermutation(partialGenerator, n, &arenas[arenaIndex],
+            scheme, targetIter);
+
+        // transpositions of previous step are not needed anymore
+        arenas[arenaIndex ^ 1].reset();
+    }
+}
+
+shared_ptr<PartialGtGenerator> GtGenerator::acquireGenerator(TranspositionArena* arena)
+{
+    shared_ptr<PartialGtGenerator> generator;
+    if (spareGenerators.size())
+    {
+        generator = spareGenerators.back();
+        spareGenerators.pop_back();
+
+        generator->setArena(arena);
+    }
+    else
+        generator = shared_ptr<PartialGtGenerator>(new PartialGtGenerator(arena, generatorOptions));
+
+    return generator;
+}
+
+void GtGenerator::releaseGenerator(shared_ptr<PartialGtGenerator> generator)
+{
+    spareGenerators.push_back(generator);
+}
+
+Scheme GtGenerator::generateWithBeamSearch(uint beamWidth)
+{
+    // greedy result is the initial upper bound
+    Scheme bestScheme;
+    {
+        Scheme::iterator targetIter = bestScheme.end();
+
+        arenas[0].reset();
+
+        shared_ptr<PartialGtGenerator> partialGenerator = acquireGenerator(&arenas[0]);
+        partialGenerator->setPermutation(permutation, n);
+        partialGenerator->prepareForGeneration();
+
+        reduceGreedily(partialGenerator, &bestScheme, &targetIter);
+    }
+
+    shared_ptr<BeamStep> bestLastStep = 0;
+    uint bestGateCount = bestScheme.size();
+
+    float timeLimit = 1000.0f * ProgramOptions::get().gtBeamTimeLimit;
+
+    Timer timer;
+    timer.start();
+
+    vector<BeamState> beam(1);
+    {
+        BeamState& initialState = beam.front();
+
+        initialState.arena = shared_ptr<TranspositionArena>(new TranspositionArena());
+        initialState.generator = shared_ptr<PartialGtGenerator>(
+            new PartialGtGenerator(initialState.arena.get(), generatorOptions));
+
+        initialState.generator->setPermutation(permutation, n);
+        initialState.generator->prepareForGeneration();
+
+        initialState.residualTranspositionCount = permutation.getTranspositionsCount();
+    }
+
+    ThreadPool& pool = ThreadPool::get();
+    bool isTimeLimitExceeded = false;
+
+    while (beam.size())
+    {
+        // expand all states in parallel
+        uint stateCount = beam.size();
+        vector<vector<BeamState>> expansions(stateCount);
+
+        pool.parallelFor(stateCount, [&](uint index)
+        {
+            expansions[index] = expandBeamState(beam[index]);
+        });
+
+        // collect new states, finished ones are compared with the best result
+        vector<BeamState> candidates;
+        candidates.reserve(2 * stateCount);
+
+        for (auto& children : expansions)
+        {
+            for (auto& child : children)
+            {
+                if (child.gateCount >= bestGateCount)
+                    continue; //can't be better than already found result
+
+                if (child.generator)
+                    candidates.push_back(child);
+                else
+                {
+                    bestGateCount = child.gateCount;
+                    bestLastStep = child.lastStep;
+                }
+            }
+        }
+
+        // the fewer transpositions left, the better, then the fewer gates used, the better
+        auto sortFunc = [](const BeamState& left, const BeamState& right) -> bool
+        {
+            if (left.residualTranspositionCount != right.residualTranspositionCount)
+                return left.residualTranspositionCount < right.residualTranspositionCount;
+
+            if (left.gateCount != right.gateCount)
+                return left.gateCount < right.gateCount;
+
+            PartialResultParams leftParams = left.generator->getPartialResultParams();
+            PartialResultParams rightParams = right.generator->getPartialResultParams();
+
+            return leftParams.isBetterThan(rightParams) && !rightParams.isBetterThan(leftParams);
+        };
+
+        stable_sort(candidates.begin(), candidates.end(), sortFunc);
+
+        if (candidates.size() > beamWidth)
+            candidates.resize(beamWidth);
+
+        beam = move(candidates);
+
+        timer.stop();
+        if (timeLimit && timer.getElapsedMs() > timeLimit)
+        {
+            isTimeLimitExceeded = true;
+            break;
+        }
+    }
+
+    // complete the best partial scheme greedily, if time is over
+    if (isTimeLimitExceeded && beam.size())
+    {
+        BeamState& state = beam.front();
+
+        Scheme scheme;
+        Scheme::iterator targetIter = scheme.end();
+
+        restoreScheme(state.lastStep, &scheme, &targetIter);
+        reduceGreedily(state.generator, &scheme, &targetIter);
+
+        if (scheme.size() < bestGateCount)
+        {
+            bestGateCount = scheme.size();
+            bestLastStep = 0;
+            bestScheme = scheme;
+        }
+    }
+
+    if (bestLastStep)
+    {
+        bestScheme.clear();
+
+        Scheme::iterator targetIter = bestScheme.end();
+        restoreScheme(bestLastStep, &bestScheme, &targetIter);
+    }
+
+    return bestScheme;
+}
+
+vector<GtGenerator::BeamState> GtGenerator::expandBeamState(BeamState& state)
+{
+    PartialGtGenerator& generator = *state.generator;
+    deque<ReverseElement> elements = generator.implementPartialResult();
+
+    vector<bool> sides = { true };
+    if (generator.isLeftAndRightMultiplicationDiffers())
+        sides.push_back(false);
+
+    vector<BeamState> children;
+    children.reserve(sides.size());
+
+    for (bool isLeftMultiplication : sides)
+    {
+        BeamState child;
+
+        child.lastStep = shared_ptr<BeamStep>(new BeamStep());
+        child.lastStep->parent = state.lastStep;
+        child.lastStep->elements = elements;
+        child.lastStep->isLeftMultiplication = isLeftMultiplication;
+
+        child.gateCount = state.gateCount + elements.size();
+
+        Permutation residualPermutation = generator.getResidualPermutation(isLeftMultiplication);
+        child.residualTranspositionCount = residualPermutation.getTranspositionsCount();
+
+        if (!residualPermutation.isEmpty())
+        {
+            child.arena = shared_ptr<TranspositionArena>(new TranspositionArena());
+            child.generator = shared_ptr<PartialGtGenerator>(
+                new PartialGtGenerator(child.arena.get(), generatorOptions));
+
+            child.generator->setPermutation(move(residualPermutation), n);
+            child.generator->prepareForGeneration();
+        }
+
+        children.push_back(child);
+    }
+
+    return children;
+}
+
+void GtGenerator::restoreScheme(shared_ptr<BeamStep> lastStep, Scheme* scheme, Scheme::iterator* targetIter)
+{
+    vector<const BeamStep*> steps;
+    for (const BeamStep* step = lastStep.get(); step; step = step->parent.get())
+        steps.push_back(step);
+
+    forrcin(step, steps)
+        insertElements((*step)->elements, (*step)->isLeftMultiplication, scheme, targetIter);
+}
+
 shared_ptr<PartialGtGenerator> GtGenerator::reducePermutation(shared_ptr<PartialGtGenerator> partialGenerator,
-    uint n, Scheme* scheme, Scheme::iterator* targetIter)
+    uint n, TranspositionArena* arena, Scheme* scheme, Scheme::iterator* targetIter)
 {
     debugLog("GtGenerator::reducePermutation()-dump-transposition-count", [&](ostream& out)->void
     {
@@ -88,19 +320,20 @@ shared_ptr<PartialGtGenerator> GtGenerator::reducePermutation(shared_ptr<Partial
     if(isLeftAndRightMultiplicationDiffers)
     {
         // get left choice
-        Permutation leftMultipliedPermutation  = partialGenerator->getResidualPermutation(true);
-        shared_ptr<PartialGtGenerator> leftGenerator(new PartialGtGenerator());
+        shared_ptr<PartialGtGenerator> leftGenerator = acquireGenerator(arena);
 
-        leftGenerator->setPermutation(leftMultipliedPermutation, n);
+        leftGenerator->setPermutation(partialGenerator->getResidualPermutation(true), n);
         leftGenerator->prepareForGeneration();
 
         // get right choice
-        Permutation rightMultipliedPermutation = partialGenerator->getResidualPermutation(false);
-        shared_ptr<PartialGtGenerator> rightGenerator(new PartialGtGenerator());
+        shared_ptr<PartialGtGenerator> rightGenerator = acquireGenerator(arena);
 
-        rightGenerator->setPermutation(rightMultipliedPermutation, n);
+        rightGenerator->setPermutation(partialGenerator->getResidualPermutation(false), n);
         rightGenerator->prepareForGeneration();
 
+        const Permutation& leftMultipliedPermutation  =  leftGenerator->getPermutation();
+        const Permutation& rightMultipliedPermutation = rightGenerator->getPermutation();
+
         debugLog("GtGenerator::reducePermutation()-dump-left-right", [&](ostream& out)->void
         {
             out << "============================\n";
@@ -128,6 +361,7 @@ shared_ptr<PartialGtGenerator> GtGenerator::reducePermutation(shared_ptr<Partial
 
             implementPartialResult(*partialGenerator, true, scheme, targetIter);
             restGenerator = leftGenerator;
+            releaseGenerator(rightGenerator);
         }
         else
         {
@@ -138,6 +372,7 @@ shared_ptr<PartialGtGenerator> GtGenerator::reducePermutation(shared_ptr<Partial
 
             implementPartialResult(*partialGenerator, false, scheme, targetIter);
             restGenerator = rightGenerator;
+            releaseGenerator(leftGenerator);
         }
     }
     else
@@ -153,12 +388,15 @@ shared_ptr<PartialGtGenerator> GtGenerator::reducePermutation(shared_ptr<Partial
                 out << "Residual:\n" << residualPermutation << endl;
             });
 
-            restGenerator = shared_ptr<PartialGtGenerator>(new PartialGtGenerator());
-            restGenerator->setPermutation(residualPermutation, n);
+            restGenerator = acquireGenerator(arena);
+            restGenerator->setPermutation(move(residualPermutation), n);
             restGenerator->prepareForGeneration();
         }
     }
 
+    // current generator is not needed anymore, it will be reused on next steps
+    releaseGenerator(partialGenerator);
+
     return restGenerator;
 }
 
@@ -166,6 +404,12 @@ void GtGenerator::implementPartialResult(PartialGtGenerator& partialGenerator,
     bool isLeftMultiplication, Scheme* scheme, Scheme::iterator* targetIter)
 {
     deque<ReverseElement> elements = partialGenerator.implementPartialResult();
+    insertElements(elements, isLeftMultiplication, scheme, targetIter);
+}
+
+void GtGenerator::insertElements(const deque<ReverseElement>& elements,
+    bool isLeftMultiplication, Scheme* scheme, Scheme::iterator* targetIter)
+{
     assertd(elements.size(), string("GtGenerator: partial result is empty"));
 
     Scheme::iterator localIterator = *targetIter;
@@ -178,7 +422,8 @@ void GtGenerator::implementPartialResult(PartialGtGenerator& partialGenerator,
     *targetIter = localIterator;
 }
 
-void GtGenerator::checkPermutationValidity(const TruthTable& table)
+template<typename Entry>
+void GtGenerator::checkPermutationValidity(const BasicTruthTable<Entry>& table)
 {
     set<word> inputs;
     set<word> outputs;
@@ -186,7 +431,7 @@ void GtGenerator::checkPermutationValidity(const TruthTable& table)
     uint transformCount = table.size();
     for(word x = 0; x < transformCount; ++x)
     {
-        const word& y = table[x];
+        word y = table[x];
 
         inputs.insert(x);
         outputs.insert(y);
@@ -199,7 +444,8 @@ void GtGenerator::checkPermutationValidity(const TruthTable& table)
            string("Number of outputs in permutation table is too small"));
 }
 
-tuple<uint, Permutation> GtGenerator::getPermutation(const TruthTable& table)
+template<typename Entry>
+tuple<uint, Permutation> GtGenerator::getPermutation(const BasicTruthTable<Entry>& table)
 {
     Permutation permutation = PermutationUtils::createPermutation(table);
 
@@ -227,4 +473,9 @@ tuple<uint, Permutation> GtGenerator::getPermutation(const TruthTable& table)
     return tie(n, permutation);
 }
 
+// packed truth tables, word is one of these types
+template Scheme GtGenerator::generate(const BasicTruthTable<uint16_t>& table);
+template Scheme GtGenerator::generate(const BasicTruthTable<uint32_t>& table);
+template Scheme GtGenerator::generate(const BasicTruthTable<uint64_t>& table);
+
 }   // namespace ReversibleLogic
@@ -29,20 +29,73 @@ public:
     GtGenerator() = default;
     virtual ~GtGenerator() = default;
 
-    Scheme generate(const TruthTable& table);
+    template<typename Entry>
+    Scheme generate(const BasicTruthTable<Entry>& table);
 
 private:
-    tuple<uint, Permutation> getPermutation(const TruthTable& table);
-    void checkPermutationValidity(const TruthTable& table);
+    template<typename Entry>
+    tuple<uint, Permutation> getPermutation(const BasicTruthTable<Entry>& table);
+
+    template<typename Entry>
+    void checkPermutationValidity(const BasicTruthTable<Entry>& table);
 
     void implementPartialResult(PartialGtGenerator& partialGenerator,
         bool isLeftMultiplication, Scheme* scheme, Scheme::iterator* targetIter);
 
+    /// Inserts @elements before @targetIter, target iterator is moved after them for left multiplication
+    void insertElements(const deque<ReverseElement>& elements,
+        bool isLeftMultiplication, Scheme* scheme, Scheme::iterator* targetIter);
+
+    /// Greedy reduction of permutation until it is empty
+    void reduceGreedily(shared_ptr<PartialGtGenerator> partialGenerator,
+        Scheme* scheme, Scheme::iterator* targetIter);
+
+    /// Generators are reused between reduction steps to keep their scratch buffers
+    shared_ptr<PartialGtGenerator> acquireGenerator(TranspositionArena* arena);
+    void releaseGenerator(shared_ptr<PartialGtGenerator> generator);
+
+    /// Beam search: on each step best @beamWidth partial schemes are kept
+    Scheme generateWithBeamSearch(uint beamWidth);
+
+    /// Elements of one reduction step with link to previous step
+    struct BeamStep
+    {
+        shared_ptr<BeamStep> parent;
+        deque<ReverseElement> elements;
+        bool isLeftMultiplication;
+    };
+
+    struct BeamState
+    {
+        shared_ptr<BeamStep> lastStep;
+
+        /// Prepared for residual permutation, null if permutation is fully reduced
+        shared_ptr<PartialGtGenerator> generator;
+        shared_ptr<TranspositionArena> arena;
+
+        uint gateCount = 0;
+        uint residualTranspositionCount = 0;
+    };
+
+    /// Returns up to two states: for left and right multiplication
+    vector<BeamState> expandBeamState(BeamState& state);
+
+    /// Makes scheme from all steps from the first one to @lastStep
+    void restoreScheme(shared_ptr<BeamStep> lastStep, Scheme* scheme, Scheme::iterator* targetIter);
+
+    /// @arena - storage for transpositions of generators created on this step
     shared_ptr<PartialGtGenerator> reducePermutation(shared_ptr<PartialGtGenerator> partialGenerator,
-        uint n, Scheme* scheme, Scheme::iterator* targetIter);
+        uint n, TranspositionArena* arena, Scheme* scheme, Scheme::iterator* targetIter);
 
     uint n = 0;
     Permutation permutation;
+
+    /// Arenas are swapped on each reduction step: one holds transpositions
+    /// of current partial generator, another one is used by the next generators
+    TranspositionArena arenas[2];
+
+    PartialGtGenerator::Options generatorOptions;
+    vector<shared_ptr<PartialGtGenerator>> spareGenerators;
 };
 
 }   // namespace ReversibleLogic
@@ -27,16 +27,33 @@ namespace ReversibleLogic
 
 Scheme GtGeneratorWithMemory::generateFast(const TruthTable& table, ostream& outputLog)
 {
-    Scheme scheme;
+    SchemeSink sink;
+    generateFast(table, &sink, outputLog);
+
+    return move(sink.getScheme());
+}
+
+void GtGeneratorWithMemory::generateFast(const TruthTable& table, GateSink* sink,
+    ostream& outputLog)
+{
+    assertd(sink, string("Null pointer (GtGeneratorWithMemory::generateFast)"));
+
     uint tableSize = table.size();
 
     uint n = 0, m = 0;
     detectBitCount(table, &n, &m);
 
+    BitSlicedSimulator simulator(n + m, n);
+
+    SplitterSink splitter;
+    splitter.addSink(sink);
+    splitter.addSink(&simulator);
+
+    uint elementCount = 0;
     for (uint coord = 0; coord < m; ++coord)
     {
         unordered_set<word> inputs;
-        word mask = 1 << coord;
+        word mask = (word)1 << coord;
 
         for (uint index = 0; index < tableSize; ++index)
         {
@@ -44,15 +61,56 @@ Scheme GtGeneratorWithMemory::generateFast(const TruthTable& table, ostream& out
                 inputs.insert(index);
         }
 
-        generateCoordinateFunction(&scheme, n, m, coord, inputs);
+        Scheme subScheme;
+        generateCoordinateFunction(&subScheme, n, m, coord, inputs);
+
+        splitter.writeElements(subScheme);
+        elementCount += subScheme.size();
     }
 
-    outputLog << "Complexity after all optimizations: " << scheme.size() << endl;
+    outputLog << "Complexity after all optimizations: " << elementCount << endl;
 
-    bool isValid = checkSchemeValidity(scheme, n, m, table);
+    bool isValid = simulator.checkOutputs(table, n, m);
     assert(isValid, string("Generated scheme is not valid"));
+}
+
+void GtGeneratorWithMemory::generateFromCubes(const PlaParser& pla, GateSink* sink,
+    ostream& outputLog)
+{
+    assertd(sink, string("Null pointer (GtGeneratorWithMemory::generateFromCubes)"));
+
+    uint n = pla.getInputCount();
+    uint m = pla.getOutputCount();
+
+    vector<word> validationInputs = getValidationInputs(pla);
+    BitSlicedSimulator simulator(n + m, validationInputs);
+
+    SplitterSink splitter;
+    splitter.addSink(sink);
+    splitter.addSink(&simulator);
+
+    uint elementCount = 0;
+    for (uint coord = 0; coord < m; ++coord)
+    {
+        Scheme subScheme;
+        generateCoordinateFunction(&subScheme, n, m, coord, pla.getCoordinateEdges(coord));
+
+        splitter.writeElements(subScheme);
+        elementCount += subScheme.size();
+    }
+
+    outputLog << "Complexity: " << elementCount << endl;
+
+    bool isValid = true;
+    word outputMask = getFullMask(m);
+
+    for (size_t index = 0; index < validationInputs.size() && isValid; ++index)
+    {
+        word y = (simulator.getOutput(index) >> n) & outputMask;
+        isValid = (y == pla.getValue(validationInputs[index]));
+    }
 
-    return scheme;
+    assert(isValid, string("Generated scheme is not valid"));
 }
 
 void GtGeneratorWithMemory::detectBitCount(const TruthTable& table, uint* n, uint* m)
@@ -124,34 +182,70 @@ void GtGeneratorWithMemory::generateCoordinateFunction(Scheme* scheme,
     scheme->insert(scheme->end(), subScheme.cbegin(), subScheme.cend());
 }
 
-bool GtGeneratorWithMemory::checkSchemeValidity(const Scheme& scheme,
-    uint n, uint m, const TruthTable& table)
+void GtGeneratorWithMemory::generateCoordinateFunction(Scheme* scheme,
+    uint n, uint m, uint coord, const vector<BooleanEdge>& edges)
 {
-    auto extractFunc = [=](word x)
+    assertd(scheme, string("Null pointer (GtGeneratorWithMemory::generateCoordinateFunction)"));
+
+    // cube elements have many control inputs, so post processing with full scheme
+    // is too expensive for them and they are written as is
+    word targetMask = (word)1 << (n + coord);
+    for (auto& edge : edges)
     {
-        word mask = ((word)1 << m) - 1;
-        word y = (x >> n) & mask;
+        word controlMask = edge.getBaseMask();
+        word inversionMask = edge.getBaseValue() ^ controlMask;
 
-        return y;
-    };
+        scheme->push_back(ReverseElement(n + m, targetMask, controlMask, inversionMask));
+    }
+}
 
-    bool isValid = true;
+vector<word> GtGeneratorWithMemory::getValidationInputs(const PlaParser& pla)
+{
+    // all inputs are checked for small functions
+    const uint numMaxExhaustiveInputCount = 12;
+    const uint numSampleCount = 1 << 12;
 
-    word count = (word)1 << n;
-    for (word x = 0; x < count; ++x)
+    uint n = pla.getInputCount();
+
+    vector<word> inputs;
+    if (n <= numMaxExhaustiveInputCount)
     {
-        word y = x;
-        for (auto& element : scheme)
-            y = element.getValue(y);
+        word count = (word)1 << n;
+        inputs.reserve((size_t)count);
 
-        if (table[x] != extractFunc(y))
-        {
-            isValid = false;
-            break;
-        }
+        for (word x = 0; x < count; ++x)
+            inputs.push_back(x);
+
+        return inputs;
+    }
+
+    // random inputs and random points of cubes, so each cube is checked at least once
+    word fullMask = getFullMask(n);
+    word seed = 0x9E3779B97F4A7C15ULL;
+
+    auto getRandomValue = [&seed]()
+    {
+        // xorshift64
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        return seed;
+    };
+
+    const vector<PlaParser::Cube>& cubes = pla.getCubes();
+    inputs.reserve(numSampleCount + min(cubes.size(), (size_t)numSampleCount));
+
+    for (uint index = 0; index < numSampleCount; ++index)
+        inputs.push_back(getRandomValue() & fullMask);
+
+    for (size_t index = 0; index < cubes.size() && index < numSampleCount; ++index)
+    {
+        const BooleanEdge& edge = cubes[index].edge;
+        inputs.push_back(edge.getBaseValue() | (getRandomValue() & edge.starsMask));
     }
 
-    return isValid;
+    return inputs;
 }
 
 } //namespace ReversibleLogic
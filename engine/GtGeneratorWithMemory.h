@@ -33,14 +33,29 @@ public:
 
     Scheme generateFast(const TruthTable& table, ostream& outputLog);
 
-private:
+    /// Emits scheme to @sink coordinate by coordinate: only elements of one coordinate
+    /// function are kept in memory, scheme is validated on the fly by simulator
+    void generateFast(const TruthTable& table, GateSink* sink, ostream& outputLog);
+
+    /// Emits scheme for function given by PLA cover to @sink without expanding it
+    /// to truth table: each edge of coordinate function gives one element.
+    /// Scheme is validated on all inputs for small functions and on sample of inputs otherwise.
+    void generateFromCubes(const PlaParser& pla, GateSink* sink, ostream& outputLog);
+
+    /// Detects number of inputs @n and outputs @m, scheme has n + m lines
     void detectBitCount(const TruthTable& table, uint* n, uint* m);
 
+private:
     void generateCoordinateFunction(Scheme* scheme,
         uint n, uint m, uint coord, unordered_set<word>& inputs);
 
-    bool checkSchemeValidity(const Scheme& scheme, uint n, uint m,
-        const TruthTable& table);
+    /// Cube-driven variant, exclusive sum of @edges is the coordinate function,
+    /// so edge search is not needed
+    void generateCoordinateFunction(Scheme* scheme,
+        uint n, uint m, uint coord, const vector<BooleanEdge>& edges);
+
+    /// Returns inputs for validation of scheme for @pla function
+    vector<word> getValidationInputs(const PlaParser& pla);
 };
 
 } //ReversibleLogic
\ No newline at end of file
@@ -0,0 +1,178 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+LineNameTable::LineNameTable(vector<string> names)
+{
+    assign(move(names));
+}
+
+void LineNameTable::assign(vector<string> newNames)
+{
+    const uint numMaxLineCount = sizeof(word) * 8;
+
+    names = move(newNames);
+    slots.clear();
+    slotMask = 0;
+    seed = 0;
+
+    uint count = names.size();
+    if (count > numMaxLineCount)
+        throw InvalidFormatException(string("Too many variables: ") + to_string(count));
+
+    if (!count)
+        return;
+
+    // unique names are needed for perfect hash, duplicates are found by sorting
+    vector<const string*> sortedNames;
+    for (auto& name : names)
+        sortedNames.push_back(&name);
+
+    sort(sortedNames.begin(), sortedNames.end(), [](const string* left, const string* right)
+    {
+        return *left < *right;
+    });
+
+    for (uint index = 1; index < count; ++index)
+    {
+        if (*sortedNames[index] == *sortedNames[index - 1])
+            throw InvalidFormatException(string("Duplicate variable name: ") + *sortedNames[index]);
+    }
+
+    // at most 64 names in 4 times more slots, so collision free seed is found fast
+    uint64_t slotCount = 1;
+    while (slotCount < 4 * count)
+        slotCount <<= 1;
+
+    slotMask = slotCount - 1;
+    slots.resize((size_t)slotCount);
+
+    bool found = false;
+    while (!found)
+    {
+        ++seed;
+        found = true;
+
+        fill(slots.begin(), slots.end(), 0);
+        for (uint index = 0; index < count && found; ++index)
+        {
+            const string& name = names[index];
+            uint8_t& slot = slots[(size_t)(getHash(name.data(), name.size(), seed) & slotMask)];
+
+            found = (slot == 0);
+            slot = (uint8_t)(index + 1);
+        }
+    }
+}
+
+void LineNameTable::assignDefault(uint count)
+{
+    vector<string> defaultNames;
+    defaultNames.reserve(count);
+
+    for (uint index = 0; index < count; ++index)
+        defaultNames.push_back(getDefaultName(index));
+
+    assign(move(defaultNames));
+}
+
+//static
+string LineNameTable::getDefaultName(uint index)
+{
+    const uint numLetterCount = 'z' - 'a' + 1;
+
+    // bijective base-26 numeration, so that first 26 names are single letters
+    string name;
+    ++index;
+
+    while (index)
+    {
+        --index;
+        name.push_back((char)('a' + index % numLetterCount));
+        index /= numLetterCount;
+    }
+
+    reverse(name.begin(), name.end());
+    return name;
+}
+
+uint LineNameTable::getCount() const
+{
+    return names.size();
+}
+
+const string& LineNameTable::getName(uint index) const
+{
+    assert(index < names.size(), string("LineNameTable::getName(): argument out of range"));
+    return names[index];
+}
+
+const vector<string>& LineNameTable::getNames() const
+{
+    return names;
+}
+
+uint LineNameTable::find(const char* name, uint length) const
+{
+    if (slots.empty())
+        return uintUndefined;
+
+    uint8_t slot = slots[(size_t)(getHash(name, length, seed) & slotMask)];
+    if (!slot)
+        return uintUndefined;
+
+    uint index = slot - 1;
+    const string& candidate = names[index];
+
+    if (candidate.size() != length || memcmp(candidate.data(), name, length))
+        return uintUndefined;
+
+    return index;
+}
+
+uint LineNameTable::find(const string& name) const
+{
+    return find(name.data(), name.size());
+}
+
+//static
+uint64_t LineNameTable::getHash(const char* name, uint length, uint64_t seed)
+{
+    // FNV-1a with seed mixed into offset basis
+    uint64_t hash = 0xcbf29ce484222325ULL ^ (seed * 0x9e3779b97f4a7c15ULL);
+    for (uint index = 0; index < length; ++index)
+    {
+        hash ^= (uint8_t)name[index];
+        hash *= 0x100000001b3ULL;
+    }
+
+    // final mixing, so that low bits depend on all bytes
+    hash ^= hash >> 29;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+} //namespace ReversibleLogic
@@ -0,0 +1,63 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Names of scheme lines (variables) for text formats: names are indexed by line,
+/// reverse lookup is done by perfect hash table built for the given set of names.
+class LineNameTable
+{
+public:
+    LineNameTable() = default;
+    explicit LineNameTable(vector<string> names);
+    virtual ~LineNameTable() = default;
+
+    /// Throws InvalidFormatException if names are not unique or there are too many of them
+    void assign(vector<string> names);
+
+    /// Fills table with default names of @count lines
+    void assignDefault(uint count);
+
+    /// Default name of @index-th line: "a", ..., "z", "aa", "ab", ..., "zz", "aaa", ...
+    static string getDefaultName(uint index);
+
+    uint getCount() const;
+    const string& getName(uint index) const;
+    const vector<string>& getNames() const;
+
+    /// Returns index of line with @name or uintUndefined
+    uint find(const char* name, uint length) const;
+    uint find(const string& name) const;
+
+private:
+    static uint64_t getHash(const char* name, uint length, uint64_t seed);
+
+    vector<string> names;
+
+    /// Slots contain line index plus one, zero means empty slot
+    vector<uint8_t> slots;
+    uint64_t slotMask = 0;
+    uint64_t seed = 0;
+};
+
+} //namespace ReversibleLogic
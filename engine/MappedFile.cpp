@@ -0,0 +1,151 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+#if !defined(__GNUC__)
+#   define WIN32_LEAN_AND_MEAN
+#   define NOMINMAX
+#   include <windows.h>
+#endif //__GNUC__
+
+namespace ReversibleLogic
+{
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#if defined(__GNUC__)
+
+bool MappedFile::open(const string& fileName)
+{
+    close();
+
+    fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+        return false;
+
+    struct stat fileInfo;
+    if (fstat(fileDescriptor, &fileInfo) != 0 || fileInfo.st_size == 0)
+    {
+        close();
+        return false;
+    }
+
+    void* mapping = mmap(0, (size_t)fileInfo.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (mapping == MAP_FAILED)
+    {
+        close();
+        return false;
+    }
+
+    data = mapping;
+    size = (uint64_t)fileInfo.st_size;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (data)
+        munmap(const_cast<void*>(data), (size_t)size);
+
+    if (fileDescriptor >= 0)
+        ::close(fileDescriptor);
+
+    data = 0;
+    size = 0;
+    fileDescriptor = -1;
+}
+
+#else //__GNUC__
+
+bool MappedFile::open(const string& fileName)
+{
+    close();
+
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        close();
+        return false;
+    }
+
+    mappingHandle = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+    if (!mappingHandle)
+    {
+        close();
+        return false;
+    }
+
+    data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        close();
+        return false;
+    }
+
+    size = (uint64_t)fileSize.QuadPart;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (data)
+        UnmapViewOfFile(data);
+
+    if (mappingHandle)
+        CloseHandle(mappingHandle);
+
+    if (fileHandle)
+        CloseHandle(fileHandle);
+
+    data = 0;
+    size = 0;
+    mappingHandle = 0;
+    fileHandle = 0;
+}
+
+#endif //__GNUC__
+
+bool MappedFile::isOpen() const
+{
+    return data != 0;
+}
+
+const void* MappedFile::getData() const
+{
+    return data;
+}
+
+uint64_t MappedFile::getSize() const
+{
+    return size;
+}
+
+}   // namespace ReversibleLogic
@@ -0,0 +1,57 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Read-only memory mapping of the whole file
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    virtual ~MappedFile();
+
+    /// Returns false if file could not be opened or mapped
+    bool open(const string& fileName);
+    void close();
+
+    bool isOpen() const;
+
+    const void* getData() const;
+    uint64_t getSize() const;
+
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const void* data = 0;
+    uint64_t size = 0;
+
+#if defined(__GNUC__)
+    int fileDescriptor = -1;
+#else //__GNUC__
+    void* fileHandle = 0;
+    void* mappingHandle = 0;
+#endif //__GNUC__
+};
+
+}   // namespace ReversibleLogic
@@ -0,0 +1,152 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+//static
+const OptimalSynthesisTable& OptimalSynthesisTable::get()
+{
+    static const OptimalSynthesisTable table;
+    return table;
+}
+
+OptimalSynthesisTable::OptimalSynthesisTable()
+    : lastGates(numPermutationCount)
+    , parents(numPermutationCount)
+    , gateCounts(numPermutationCount, (uint8_t)uintUndefined)
+{
+    // all gates on 3 lines, each control line could be absent, straight or inverted
+    vector<Gate> allGates;
+    vector<uint> gateCosts;
+    for (uint target = 0; target < numLineCount; ++target)
+    {
+        uint freeMask = ((1 << numLineCount) - 1) ^ (1 << target);
+        for (uint controlMask = 0; controlMask <= freeMask; ++controlMask)
+        {
+            if ((controlMask & freeMask) != controlMask)
+                continue;
+
+            for (uint inversionMask = 0; inversionMask <= controlMask; ++inversionMask)
+            {
+                if ((inversionMask & controlMask) != inversionMask)
+                    continue;
+
+                allGates.push_back(TemplateLibrary::makeGate(target, controlMask, inversionMask));
+
+                ReverseElement element(numLineCount, (word)1 << target, controlMask, inversionMask);
+                gateCosts.push_back(SchemeUtils::getElementQuantumCost(element));
+            }
+        }
+    }
+
+    vector<uint> costs(numPermutationCount, uintUndefined);
+    vector<TruthTable> frontier;
+
+    TruthTable identity = TemplateLibrary::getIdentity();
+    uint identityRank = getRank(identity);
+    gateCounts[identityRank] = 0;
+    costs[identityRank] = 0;
+    frontier.push_back(identity);
+
+    uint allGateCount = allGates.size();
+    while (frontier.size())
+    {
+        vector<TruthTable> nextFrontier;
+        uint gateCount = maxGateCount + 1;
+
+        for (auto table : frontier)
+        {
+            uint rank = getRank(table);
+            for (uint gateIndex = 0; gateIndex < allGateCount; ++gateIndex)
+            {
+                TruthTable next = TemplateLibrary::applyGate(table, allGates[gateIndex]);
+                uint nextRank = getRank(next);
+                uint cost = costs[rank] + gateCosts[gateIndex];
+
+                bool isNew = (gateCounts[nextRank] == (uint8_t)uintUndefined);
+                if (!isNew && (gateCounts[nextRank] < gateCount || costs[nextRank] <= cost))
+                    continue;
+
+                if (isNew)
+                    nextFrontier.push_back(next);
+
+                gateCounts[nextRank] = (uint8_t)gateCount;
+                costs[nextRank] = cost;
+                lastGates[nextRank] = allGates[gateIndex];
+                parents[nextRank] = (uint16_t)rank;
+            }
+        }
+
+        if (nextFrontier.size())
+            maxGateCount = gateCount;
+
+        frontier.swap(nextFrontier);
+    }
+}
+
+void OptimalSynthesisTable::findCircuit(TruthTable table, vector<Gate>* circuit) const
+{
+    assertd(circuit, string("OptimalSynthesisTable::findCircuit(): null ptr"));
+
+    circuit->clear();
+
+    uint rank = getRank(table);
+    while (gateCounts[rank])
+    {
+        circuit->push_back(lastGates[rank]);
+        rank = parents[rank];
+    }
+
+    reverse(circuit->begin(), circuit->end());
+}
+
+uint OptimalSynthesisTable::getGateCount(TruthTable table) const
+{
+    return gateCounts[getRank(table)];
+}
+
+uint OptimalSynthesisTable::getMaxGateCount() const
+{
+    return maxGateCount;
+}
+
+//static
+uint OptimalSynthesisTable::getRank(TruthTable table)
+{
+    // Lehmer code of permutation of the first 8 values
+    uint rank = 0;
+    uint usedMask = 0;
+    for (uint index = 0; index < numValueCount; ++index)
+    {
+        uint value = (table >> (index << 2)) & 0xF;
+        assertd(value < numValueCount, string("OptimalSynthesisTable::getRank(): 4th line is changed"));
+
+        uint lessCount = countNonZeroBits(usedMask & ((1 << value) - 1));
+        rank = rank * (numValueCount - index) + (value - lessCount);
+        usedMask |= 1 << value;
+    }
+
+    return rank;
+}
+
+}   // namespace ReversibleLogic
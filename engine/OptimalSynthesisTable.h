@@ -0,0 +1,74 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Table of circuits with minimal number of gates for all 8! permutations of 3 lines.
+/// Table is built once by breadth-first search, circuit with less quantum cost
+/// is preferred among circuits with the same number of gates.
+/// Gates and truth tables are in TemplateLibrary format, the 4th line is unused.
+class OptimalSynthesisTable
+{
+public:
+    enum
+    {
+        numLineCount = 3,
+        numValueCount = 1 << numLineCount,
+        numPermutationCount = 40320, // 8!
+    };
+
+    typedef TemplateLibrary::Gate Gate;
+    typedef TemplateLibrary::TruthTable TruthTable;
+
+    virtual ~OptimalSynthesisTable() = default;
+
+    static const OptimalSynthesisTable& get();
+
+    /// Returns minimal circuit for @table, which shouldn't change the 4th line
+    void findCircuit(TruthTable table, vector<Gate>* circuit) const;
+
+    /// Returns minimal number of gates for @table
+    uint getGateCount(TruthTable table) const;
+
+    /// Returns max number of gates in circuits of table
+    uint getMaxGateCount() const;
+
+private:
+    OptimalSynthesisTable();
+
+    OptimalSynthesisTable(const OptimalSynthesisTable&) = delete;
+    OptimalSynthesisTable& operator=(const OptimalSynthesisTable&) = delete;
+
+    /// Returns index of permutation in lexicographic order
+    static uint getRank(TruthTable table);
+
+    /// Gate, which is the last in circuit of permutation, and index of
+    /// permutation implemented by all other gates of circuit
+    vector<Gate> lastGates;
+    vector<uint16_t> parents;
+    vector<uint8_t> gateCounts;
+
+    uint maxGateCount = 0;
+};
+
+}   // namespace ReversibleLogic
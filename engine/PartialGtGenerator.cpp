@@ -23,24 +23,71 @@
 namespace ReversibleLogic
 {
 
-PartialGtGenerator::PartialGtGenerator(uint packSize /*= uintUndefined*/)
+PartialGtGenerator::Options PartialGtGenerator::Options::load(uint packSize /*= uintUndefined*/)
+{
+    const ProgramOptions& programOptions = ProgramOptions::get();
+
+    Options result;
+    result.maxPackSize = packSize;
+    if (result.maxPackSize == uintUndefined)
+        result.maxPackSize = programOptions.transpositionsPackSize;
+
+    if (programOptions.isTuningEnabled)
+    {
+        const Values& values = programOptions.options;
+
+        result.isResultComparisonNeeded = values.getBool("compare-results-on-edge-search",
+            result.isResultComparisonNeeded);
+
+        result.sortByWeightNotFrequency = values.getBool("sort-by-weight-not-frequency",
+            result.sortByWeightNotFrequency);
+
+        result.searchForBooleanEdges = values.getBool("search-for-boolean-edges",
+            result.searchForBooleanEdges);
+
+        result.reversePackOrder = values.getBool("transpositions-pack-in-reverse-order",
+            result.reversePackOrder);
+    }
+
+    return result;
+}
+
+PartialGtGenerator::PartialGtGenerator(TranspositionArena* arena, uint packSize /*= uintUndefined*/)
+    : PartialGtGenerator(arena, Options::load(packSize))
+{
+}
+
+PartialGtGenerator::PartialGtGenerator(TranspositionArena* arena, const Options& theOptions)
     : permutation()
     , n(uintUndefined)
-    , maxPackSize(packSize)
+    , options(theOptions)
+    , arena(arena)
 {
-    if (maxPackSize == uintUndefined)
-        maxPackSize = ProgramOptions::get().transpositionsPackSize;
+    assertd(arena, string("PartialGtGenerator: null arena"));
 
-    assert(countNonZeroBits(maxPackSize) == 1,
+    assert(countNonZeroBits(options.maxPackSize) == 1,
         string("Transpositions pack size should be power of 2"));
 }
 
+void PartialGtGenerator::setArena(TranspositionArena* theArena)
+{
+    assertd(theArena, string("PartialGtGenerator: null arena"));
+    arena = theArena;
+}
+
 void PartialGtGenerator::setPermutation(const Permutation& thePermutation, uint inputCount)
 {
-    permutation = thePermutation;
+    setPermutation(Permutation(thePermutation), inputCount);
+}
+
+void PartialGtGenerator::setPermutation(Permutation&& thePermutation, uint inputCount)
+{
+    permutation = move(thePermutation);
     n = inputCount;
 
     assertd(n != uintUndefined, string("PartialGtGenerator: input count not defined"));
+
+    partialResultParams = PartialResultParams();
     partialResultParams.edge.n = n;
 }
 
@@ -75,28 +122,9 @@ bool PartialGtGenerator::isLeftAndRightMultiplicationDiffers() const
 
 void PartialGtGenerator::prepareForGeneration()
 {
-    // tuning options
-    bool isResultComparisonNeeded = false;
-    bool sortByWeightNotFrequency = false;
-    bool searchForBooleanEdges = true;
-
-    if (ProgramOptions::get().isTuningEnabled)
-    {
-        const Values& options = ProgramOptions::get().options;
-
-        isResultComparisonNeeded = options.getBool("compare-results-on-edge-search",
-            isResultComparisonNeeded);
-
-        sortByWeightNotFrequency = options.getBool("sort-by-weight-not-frequency",
-            sortByWeightNotFrequency);
-
-        searchForBooleanEdges = options.getBool("search-for-boolean-edges",
-            searchForBooleanEdges);
-    }
-
     // prepare all cycles in permutation for disjoint
-    unordered_map<word, uint> frequencyMap;
-    for (auto cycle : permutation)
+    frequencyMap.clear();
+    for (const auto& cycle : permutation)
         cycle->prepareForDisjoint(&frequencyMap);
 
     // sort keys by length
@@ -109,7 +137,7 @@ void PartialGtGenerator::prepareForGeneration()
         uint rightFreq = frequencyMap[right];
 
         bool isLess = false;
-        if (sortByWeightNotFrequency)
+        if (options.sortByWeightNotFrequency)
         {
             isLess = (leftWeight < rightWeight);
             if(leftWeight == rightWeight)
@@ -122,43 +150,54 @@ void PartialGtGenerator::prepareForGeneration()
                 isLess = (leftWeight < rightWeight);
         }
 
+        // fixed order for equal keys, so result doesn't depend on hash order
+        if (leftWeight == rightWeight && leftFreq == rightFreq)
+            isLess = (left < right);
+
         return isLess;
     };
 
-    vector<uint> keys;
+    keys.clear();
     keys.reserve(frequencyMap.size());
 
-    for (auto iter : frequencyMap)
+    for (const auto& iter : frequencyMap)
         keys.push_back(iter.first);
 
     sort(keys.begin(), keys.end(), sortFunction);
 
     PartialResultParams bestResult;
-    if (searchForBooleanEdges)
+    if (options.searchForBooleanEdges)
     {
         // now find the best diff for disjoint
-        shared_ptr<list<Transposition>> transpositions(new list<Transposition>);
+        // only transpositions of the best result are kept in arena, they are stored from @bestPosition
+        uint bestPosition = arena->getPosition();
 
         uint keyCount = keys.size();
         for (uint index = 0; index < keyCount; ++index)
         {
             word diff = keys[index];
-            uint freq = frequencyMap[diff];
+            uint position = arena->getPosition();
 
-            transpositions->resize(0);
-            for (auto cycle : permutation)
-                cycle->disjointByDiff(diff, transpositions);
+            for (const auto& cycle : permutation)
+                cycle->disjointByDiff(diff, arena);
 
-            if (transpositions->size() == 1)
+            TranspositionSpan transpositions = arena->makeSpan(position);
+            if (transpositions.size() == 1)
+            {
+                arena->rewind(position);
                 continue;
+            }
 
             PartialResultParams result = getPartialResult(transpositions, diff, bestResult);
 
-            if ((isResultComparisonNeeded && !bestResult.isBetterThan(result)) ||
+            if ((options.isResultComparisonNeeded && !bestResult.isBetterThan(result)) ||
                 result.edge.coveredTranspositionCount > bestResult.edge.coveredTranspositionCount)
             {
                 bestResult = result;
+                bestResult.transpositions = arena->relocate(result.transpositions, bestPosition);
             }
+            else
+                arena->rewind(position);
         }
     }
 
@@ -166,28 +205,28 @@ void PartialGtGenerator::prepareForGeneration()
         bestResult.type != PartialResultParams::tEdge)
     {
         // try to retrieve transpositions pack
-        shared_ptr<list<Transposition>> transpositions = getTranspositionsPack(frequencyMap);
+        TranspositionSpan transpositions = getTranspositionsPack(keys);
     
-        if (transpositions->size())
+        if (transpositions.size())
         {
             bestResult.type = PartialResultParams::tPack;
             bestResult.transpositions = transpositions;
-            bestResult.params.packSize = transpositions->size();
+            bestResult.params.packSize = transpositions.size();
         }
     }
 
     if(bestResult.type == PartialResultParams::tNone)
     {
-        shared_ptr<list<Transposition>> transpositions = getCommonPair();
+        TranspositionSpan transpositions = getCommonPair();
 
-        assertd(transpositions->size() > 1,
+        assertd(transpositions.size() > 1,
             string("PartialGtGenerator::prepareForGeneration() failed to find common pair"));
 
         bestResult.type = PartialResultParams::tCommonPair;
         bestResult.transpositions = transpositions;
 
-        Transposition& firstTransp = transpositions->front();
-        Transposition& secondTransp = transpositions->back();
+        Transposition& firstTransp = transpositions.front();
+        Transposition& secondTransp = transpositions.back();
 
         word leftDiff  =  firstTransp.getDiff();
         word rightDiff = secondTransp.getDiff();
@@ -205,138 +244,195 @@ void PartialGtGenerator::prepareForGeneration()
     partialResultParams.distancesSum = permutation.getDistancesSum();
 }
 
-shared_ptr<list<Transposition>> PartialGtGenerator::getTranspositionsPack(const unordered_map<word, uint>& frequencyMap)
+TranspositionSpan PartialGtGenerator::getTranspositionsPack(const vector<word>& diffs)
 {
     // we should obtain no more than @maxPackSize transpositions
     // if there are not enough transpositions, result list size should be power of two
 
-    bool reverseOrder = true;
-    if (ProgramOptions::get().isTuningEnabled)
-        reverseOrder = ProgramOptions::get().options.getBool(
-        "transpositions-pack-in-reverse-order", reverseOrder);
+    // All transpositions are taken from the original permutation. They should be independent
+    // and should not cross each other inside of one cycle: then each of them splits some cycle
+    // no matter in what order they are multiplied, so there is no need to modify permutation.
 
-    unordered_set<word> visited;
+    uint maxPackSize = options.maxPackSize;
 
-    shared_ptr<list<Transposition>> result(new list<Transposition>);
-    shared_ptr<list<Transposition>> temp(new list<Transposition>);
+    // 1) index of all elements, sorted by element value
+    locations.clear();
+    locations.reserve(permutation.getElementCount());
 
-    Permutation permCopy = permutation.clone();
-    bool stopFlag = false;
-
-    for (auto iter : frequencyMap)
+    uint cycleIndex = 0;
+    for (const auto& cycle : permutation)
     {
-        word diff = iter.first;
-        temp->resize(0);
-        
-        for (auto cycle : permCopy)
-            cycle->disjointByDiff(diff, temp);
+        uint elementCount = cycle->length();
+        for (uint position = 0; position < elementCount; ++position)
+            locations.push_back({ (*cycle)[position], cycleIndex, position });
 
-        temp->remove_if(
-            [&](const Transposition& t)
-            {
-                return visited.find(t.getX()) != visited.cend() ||
-                    visited.find(t.getY()) != visited.cend();
-            }
-        );
+        ++cycleIndex;
+    }
 
-        stopFlag = temp->size() == 0;
-        if (stopFlag)
-            break;
+    sort(locations.begin(), locations.end(),
+        [](const ElementLocation& left, const ElementLocation& right) -> bool
+        {
+            return left.element < right.element;
+        }
+    );
 
-        // it really doesn't matter what multiplication is (left or right)
-        // but this is only because we trying to obtain independent transpositions
-        permCopy = permCopy.multiplyByTranspositions(temp, true); 
+    uint locationCount = locations.size();
+    auto findLocation = [&](word element) -> uint
+    {
+        uint first = 0;
+        uint last = locationCount;
 
-        for (auto& t : *temp)
+        while (first < last)
         {
-            if (reverseOrder)
-                result->push_front(t);
+            uint middle = (first + last) / 2;
+            if (locations[middle].element < element)
+                first = middle + 1;
             else
-                result->push_back(t);
+                last = middle;
+        }
+
+        return (first < locationCount && locations[first].element == element ? first : uintUndefined);
+    };
+
+    // 2) visited bitmap over location indices
+    visited.assign((locationCount + numBitsInWord - 1) / numBitsInWord, 0);
+
+    auto isVisited = [&](uint index) -> bool
+    {
+        return (visited[index / numBitsInWord] >> (index % numBitsInWord)) & 1;
+    };
+
+    auto setVisited = [&](uint index)
+    {
+        visited[index / numBitsInWord] |= (word)1 << (index % numBitsInWord);
+    };
+
+    // 3) selected transpositions as chords of cycles
+    chords.clear();
+    chords.reserve(maxPackSize);
+
+    auto isCrossing = [&](uint cycleIndex, uint first, uint second) -> bool
+    {
+        if (first > second)
+            swap(first, second);
+
+        for (const Chord& chord : chords)
+        {
+            if (chord.cycleIndex != cycleIndex)
+                continue;
+
+            uint left  = min(chord.first, chord.second);
+            uint right = max(chord.first, chord.second);
+
+            bool isFirstInside  = (left < first  && first  < right);
+            bool isSecondInside = (left < second && second < right);
 
-            visited.insert(t.getX());
-            visited.insert(t.getY());
+            if (isFirstInside != isSecondInside)
+                return true;
         }
 
-        if (result->size() >= maxPackSize)
-            break;
-    }
+        return false;
+    };
 
-    if (result->size() > maxPackSize)
-        result->resize(maxPackSize);
-    else
+    auto addChord = [&](uint xIndex, uint yIndex)
     {
-        // trying to get maximum possible number 
-        getTranspositionsPack(result, &permCopy, &visited, reverseOrder);
+        const ElementLocation& x = locations[xIndex];
+        const ElementLocation& y = locations[yIndex];
 
-        uint size = result->size();
+        chords.push_back({ x.cycleIndex, x.position, y.position });
 
-        // make from @size power of 2
-        word maxSize = maxPackSize;
-        while (maxSize > size)
-            maxSize >>= 1;
+        setVisited(xIndex);
+        setVisited(yIndex);
+    };
 
-        assert(maxSize, string("getTranspositionsPack(): error with calculation of result max size"));
-        result->resize(maxSize);
-    }
+    // 4) transpositions with the same diff in order of diffs
+    for (word diff : diffs)
+    {
+        uint chordCount = chords.size();
 
-    return result;
-}
+        for (uint xIndex = 0; xIndex < locationCount && chords.size() < maxPackSize; ++xIndex)
+        {
+            word x = locations[xIndex].element;
+            word y = x ^ diff;
 
-void PartialGtGenerator::getTranspositionsPack(shared_ptr<list<Transposition>> result,
-    Permutation* permCopy, unordered_set<word>* visited, bool reverseOrder)
-{
-    uint maxSize = maxPackSize - result->size();
-    if (!maxSize)
-        return;
+            // each pair is considered once
+            if (y < x || isVisited(xIndex))
+                continue;
 
-    list<Transposition> temp;
-        
-    for (auto cycle : *permCopy)
+            uint yIndex = findLocation(y);
+            if (yIndex == uintUndefined || isVisited(yIndex))
+                continue;
+
+            uint cycleIndex = locations[xIndex].cycleIndex;
+            if (locations[yIndex].cycleIndex != cycleIndex)
+                continue;
+
+            if (isCrossing(cycleIndex, locations[xIndex].position, locations[yIndex].position))
+                continue;
+
+            addChord(xIndex, yIndex);
+        }
+
+        if (chords.size() == chordCount || chords.size() >= maxPackSize)
+            break;
+    }
+
+    // 5) trying to get maximum possible number: pair neighbour free elements in each cycle
+    cycleIndex = 0;
+    for (const auto& cycle : permutation)
     {
-        uint pos = 0;
-        word buffer[2] = {}; //for x and y
+        if (chords.size() >= maxPackSize)
+            break;
+
+        uint pendingIndex = uintUndefined;
 
         uint elementCount = cycle->length();
-        for (uint index = 0; index < elementCount; ++index)
+        for (uint position = 0; position < elementCount && chords.size() < maxPackSize; ++position)
         {
-            word element = (*cycle)[index];
-            if (visited->find(element) == visited->cend())
+            uint index = findLocation((*cycle)[position]);
+            if (isVisited(index))
+                continue;
+
+            if (pendingIndex != uintUndefined &&
+                !isCrossing(cycleIndex, locations[pendingIndex].position, position))
             {
-                buffer[pos++] = element;
-                visited->insert(element);
+                addChord(pendingIndex, index);
+                pendingIndex = uintUndefined;
             }
-
-            if (pos == 2)
-                break;
+            else
+                pendingIndex = index;
         }
 
-        if (pos == 2)
-            temp.push_back(Transposition(buffer[0], buffer[1]));
+        ++cycleIndex;
     }
 
-    uint tempSize = temp.size();
-    if (tempSize == 0)
-        return;
+    // make from size power of 2
+    uint size = chords.size();
 
-    if (tempSize > maxSize)
-        temp.resize(maxSize);
+    uint maxSize = maxPackSize;
+    while (maxSize > size)
+        maxSize >>= 1;
 
-    if (reverseOrder)
-        result->insert(result->begin(), temp.crbegin(), temp.crend());
-    else
-        result->insert(result->end(), temp.cbegin(), temp.cend());
+    assert(maxSize, string("getTranspositionsPack(): error with calculation of result max size"));
+    chords.resize(maxSize);
 
-    if (result->size() < maxPackSize)
+    // 6) make result
+    if (options.reversePackOrder)
+        reverse(chords.begin(), chords.end());
+
+    uint position = arena->getPosition();
+    for (const Chord& chord : chords)
     {
-        *permCopy = permCopy->multiplyByTranspositions(temp, true);
-        getTranspositionsPack(result, permCopy, visited, reverseOrder);
+        const Cycle& cycle = *permutation.getCycle(chord.cycleIndex);
+        arena->push(cycle[chord.first], cycle[chord.second]);
     }
+
+    return arena->makeSpan(position);
 }
 
-shared_ptr<list<Transposition>> PartialGtGenerator::getCommonPair()
+TranspositionSpan PartialGtGenerator::getCommonPair()
 {
-    shared_ptr<list<Transposition>> transpositions(new list<Transposition>);
+    uint position = arena->getPosition();
     if (permutation.length() > 1)
     {
         auto iter = permutation.begin();
@@ -344,25 +440,25 @@ shared_ptr<list<Transposition>> PartialGtGenerator::getCommonPair()
         iter++;
         Cycle& secondCycle = **iter;
 
-        transpositions->push_back(Transposition(firstCycle[0], firstCycle[1]));
-        transpositions->push_back(Transposition(secondCycle[0], secondCycle[1]));
+        arena->push(firstCycle[0], firstCycle[1]);
+        arena->push(secondCycle[0], secondCycle[1]);
     }
     else
     {
         Cycle& cycle = **(permutation.begin());
         if (cycle.length() >= 4)
         {
-            transpositions->push_back(Transposition(cycle[0], cycle[1]));
-            transpositions->push_back(Transposition(cycle[2], cycle[3]));
+            arena->push(cycle[0], cycle[1]);
+            arena->push(cycle[2], cycle[3]);
         }
         else
         {
             word x = cycle[0];
             word y = cycle[1];
 
-            transpositions->push_back(Transposition(x, y));
+            arena->push(x, y);
 
-            uint mask = 1;
+            word mask = 1;
             while (true)
             {
                 word a = x ^ mask;
@@ -370,22 +466,22 @@ shared_ptr<list<Transposition>> PartialGtGenerator::getCommonPair()
 
                 if (!cycle.has(a) && !cycle.has(b))
                 {
-                    transpositions->push_back(Transposition(a, b));
+                    arena->push(a, b);
                     break;
                 }
 
                 mask <<= 1;
             }
 
-            assert(transpositions->size() == 2, string("wrong representation of 3-cycle"));
+            assert(arena->getPosition() - position == 2, string("wrong representation of 3-cycle"));
         }
     }
 
-    return transpositions;
+    return arena->makeSpan(position);
 }
 
 PartialResultParams PartialGtGenerator::getPartialResult(
-    shared_ptr<list<Transposition>> transpositions, word diff,
+    const TranspositionSpan& transpositions, word diff,
     const PartialResultParams& bestParams)
 {
     BooleanEdgeSearcher edgeSearcher(transpositions, n, diff);
@@ -398,7 +494,7 @@ PartialResultParams PartialGtGenerator::getPartialResult(
         if(capacity >= bestParams.params.edgeCapacity)
         {
             result.type = (edge.isFull() ? PartialResultParams::tFullEdge : PartialResultParams::tEdge);
-            result.transpositions = edgeSearcher.getEdgeSubset(edge, n);
+            result.transpositions = edgeSearcher.getEdgeSubset(edge, n, arena);
 
             edge = BooleanEdgeSearcher(result.transpositions, n, diff).findEdge();
             result.edge = edge;
@@ -424,14 +520,14 @@ PartialResultParams PartialGtGenerator::getPartialResultParams() const
     return partialResultParams;
 }
 
-shared_ptr<list<Transposition>> PartialGtGenerator::findBestCandidates(shared_ptr<list<Transposition>> candidates)
+TranspositionSpan PartialGtGenerator::findBestCandidates(const TranspositionSpan& candidates)
 {
     sortCandidates(candidates);
 
-    uint candidateCount = candidates->size();
+    uint candidateCount = candidates.size();
     assertd(candidateCount > 1, string("PartialGtGenerator: too few candidates for findBestCandidates()"));
 
-    auto iter = candidates->begin();
+    auto iter = candidates.begin();
 
     // find best partner for first transposition among candidates
     Transposition firstPartner;
@@ -451,26 +547,24 @@ shared_ptr<list<Transposition>> PartialGtGenerator::findBestCandidates(shared_pt
 
     if(firstDist <= secondDist)
     {
-        first  = candidates->front();
+        first  = candidates.front();
         second = firstPartner;
     }
     else
     {
-        auto iter = candidates->begin();
-        ++iter;
-
-        first  = *iter;
+        first  = candidates[1];
         second = secondPartner;
     }
 
-    shared_ptr<list<Transposition>> result(new list<Transposition>);
-    result->push_back(first);
-    result->push_back(second);
+    uint position = arena->getPosition();
 
-    return result;
+    arena->push(first);
+    arena->push(second);
+
+    return arena->makeSpan(position);
 }
 
-void PartialGtGenerator::sortCandidates( shared_ptr<list<Transposition>> candidates )
+void PartialGtGenerator::sortCandidates(const TranspositionSpan& candidates)
 {
     struct CandSortKey
     {
@@ -478,10 +572,10 @@ void PartialGtGenerator::sortCandidates( shared_ptr<list<Transposition>> candida
         Transposition transp;
     };
 
-    vector<CandSortKey> keys(candidates->size());
+    vector<CandSortKey> keys(candidates.size());
     uint index = 0;
 
-    for (auto& transp : *candidates)
+    for (auto& transp : candidates)
     {
         word minValue = min(transp.getX(), transp.getY());
         keys[index].weight = countNonZeroBits(minValue);
@@ -497,7 +591,7 @@ void PartialGtGenerator::sortCandidates( shared_ptr<list<Transposition>> candida
     sort(keys.begin(), keys.end(), sortFunc);
 
     index = 0;
-    for (auto& t : *candidates)
+    for (auto& t : candidates)
     {
         t = keys[index].transp;
         ++index;
@@ -506,13 +600,13 @@ void PartialGtGenerator::sortCandidates( shared_ptr<list<Transposition>> candida
 
 tuple<Transposition, uint>
 PartialGtGenerator::findBestCandidatePartner(
-    const shared_ptr<list<Transposition>> candidates, const Transposition& target)
+    const TranspositionSpan& candidates, const Transposition& target)
 {
     Transposition second;
     uint minDist = uintUndefined;
 
     auto count = countNonZeroBits;
-    for (auto& cand : *candidates)
+    for (auto& cand : candidates)
     {
         uint dxz = uintUndefined;
         uint dxw = uintUndefined;
@@ -550,7 +644,7 @@ ReversibleLogic::Permutation PartialGtGenerator::getResidualPermutation(bool isL
 
 deque<ReverseElement> PartialGtGenerator::implementPartialResult()
 {
-    assertd(partialResultParams.transpositions->size(), string("PartialGtGenerator: no transpositions to synthesize"));
+    assertd(partialResultParams.transpositions.size(), string("PartialGtGenerator: no transpositions to synthesize"));
 
     deque<ReverseElement> synthesisResult;
     switch(partialResultParams.type)
@@ -575,7 +669,7 @@ deque<ReverseElement> PartialGtGenerator::implementPartialResult()
 
 deque<ReverseElement> PartialGtGenerator::implementEdge()
 {
-    const Transposition& transp = partialResultParams.transpositions->front();
+    const Transposition& transp = partialResultParams.transpositions.front();
     word diff = transp.getDiff();
 
     BooleanEdge& edge = partialResultParams.edge;
@@ -602,11 +696,11 @@ deque<ReverseElement> PartialGtGenerator::implementEdge()
 
 deque<ReverseElement> PartialGtGenerator::implementPairOfTranspositions()
 {
-    assertd(partialResultParams.transpositions->size() == 2,
+    assertd(partialResultParams.transpositions.size() == 2,
         string("PartialGtGenerator: can't implement pair of transpositions"));
 
-    Transposition firstTransp  = partialResultParams.transpositions->front();
-    Transposition secondTransp = partialResultParams.transpositions->back();
+    Transposition firstTransp  = partialResultParams.transpositions.front();
+    Transposition secondTransp = partialResultParams.transpositions.back();
 
     deque<ReverseElement> elements;
 
@@ -666,65 +760,40 @@ deque<ReverseElement> PartialGtGenerator::implementSingleTransposition(const Tra
     return elements;
 }
 
-deque<ReverseElement> PartialGtGenerator::implementIndependentTranspositions(shared_ptr<list<Transposition>> transp)
+deque<ReverseElement> PartialGtGenerator::implementIndependentTranspositions(const TranspositionSpan& transp)
 {
-    deque<ReverseElement> elements;
-
-    uint k = transp->size() * 2;
-    assert(k <= countNonZeroBits((word)-1),
+    uint k = transp.size() * 2;
+    assert(n >= numBitsInWord || k <= ((word)1 << n),
         string("implementIndependentTranspositions(): too many rows"));
 
     assertd(countNonZeroBits(k) == 1,
         string("implementIndependentTranspositions(): only power of 2 is allowed for vector count"));
 
-    uint baseVectorCount = (uint)(log(k) / log(2));
-
     // make matrix
     vector<word> matrix;
     matrix.reserve(k);
 
-    for (const Transposition& t : *transp)
+    for (const Transposition& t : transp)
     {
         matrix.push_back(t.getX());
         matrix.push_back(t.getY());
     }
 
-    // transpose matrix
-    vector<word> transposedMatrix = transposeMatrix(matrix, n);
-
-    // remove columns copies
-    MatrixMix mix;
-    word inversionMask = 0;
-
-    {
-        auto conjugationElements = removeColumnsCopies(transposedMatrix, k, &mix, &inversionMask);
-        elements.insert(elements.cend(), conjugationElements.cbegin(), conjugationElements.cend());
-    }
-
-    // reorder columns
-    uint matrixWidth = mix.columns.size();
-    mix = reorderMatrixColumns(mix, k);
-
-    // transform matrix to canonical form
-    {
-        auto conjugationElements = transformMatrixToCanonicalForm(&mix, matrixWidth, &inversionMask);
-        elements.insert(elements.cend(), conjugationElements.cbegin(), conjugationElements.cend());
-    }
-
-    // conjugate core element
-    {
-        word controlMask = (1 << n) - 1;
-        for (uint index = 0; index < baseVectorCount; ++index)
-            controlMask ^= (word)1 << mix.columnIndexMap[index];
-
-        ReverseElement element(n, 1 << mix.columnIndexMap[0], controlMask, inversionMask);
-        elements = conjugate(deque<ReverseElement>{ element }, elements);
-    }
+    // choose the narrowest column type, which could hold k bits
+    deque<ReverseElement> elements;
+    if (k <= numBitsInWord)
+        elements = implementIndependentTranspositions<word>(matrix);
+    else if (k <= 2 * numBitsInWord)
+        elements = implementIndependentTranspositions<WideWord<2>>(matrix);
+    else if (k <= 4 * numBitsInWord)
+        elements = implementIndependentTranspositions<WideWord<4>>(matrix);
+    else
+        elements = implementIndependentTranspositions<DynamicWord>(matrix);
 
     debugBehavior("PartialGtGenerator::implementIndependentTranspositions()-check-validity", [&]()->void
     {
         unordered_map<word, word> table;
-        for (uint index = 0; index < ((uint)1 << n); ++index)
+        for (word index = 0; index < ((word)1 << n); ++index)
         {
             word x = index;
             word y = x;
@@ -739,7 +808,7 @@ deque<ReverseElement> PartialGtGenerator::implementIndependentTranspositions(sha
         assertd(table.size() == k,
             string("implementIndependentTranspositions(): validity check failed (count)"));
         
-        for (auto& t : *transp)
+        for (auto& t : transp)
         {
             word x = t.getX();
             word y = t.getY();
@@ -755,42 +824,59 @@ deque<ReverseElement> PartialGtGenerator::implementIndependentTranspositions(sha
     return elements;
 }
 
-vector<word> PartialGtGenerator::transposeMatrix(const vector<word>& matrix, uint m) const
+template<typename ColumnType>
+deque<ReverseElement> PartialGtGenerator::implementIndependentTranspositions(const vector<word>& matrix)
 {
-    vector<word> transposed;
-    transposed.reserve(m);
+    deque<ReverseElement> elements;
 
     uint k = matrix.size();
-    word mask = 1;
+    uint baseVectorCount = findPositiveBitPosition(k);
+
+    // transpose matrix
+    vector<ColumnType> transposedMatrix = BitMatrixUtils::transpose<ColumnType>(matrix, n);
+
+    // remove columns copies
+    MatrixMix mix;
+    vector<ColumnType> columns;
+    word inversionMask = 0;
 
-    for (uint index = 0; index < m; ++index)
     {
-        word column = 0;
-        uint pos = 1;
+        auto conjugationElements = removeColumnsCopies(transposedMatrix, k, &mix, &columns, &inversionMask);
+        elements.insert(elements.cend(), conjugationElements.cbegin(), conjugationElements.cend());
+    }
 
-        for (auto row : matrix)
-        {
-            if (row & mask)
-                column |= pos;
+    // reorder columns
+    uint matrixWidth = columns.size();
+    mix = reorderMatrixColumns(columns, mix, k);
 
-            pos <<= 1;
-        }
+    // transform matrix to canonical form
+    {
+        auto conjugationElements = transformMatrixToCanonicalForm(&mix, matrixWidth, &inversionMask);
+        elements.insert(elements.cend(), conjugationElements.cbegin(), conjugationElements.cend());
+    }
 
-        transposed.push_back(column);
-        mask <<= 1;
+    // conjugate core element
+    {
+        word controlMask = BitVectorTraits<word>::createMask(n);
+        for (uint index = 0; index < baseVectorCount; ++index)
+            controlMask ^= (word)1 << mix.columnIndexMap[index];
+
+        ReverseElement element(n, (word)1 << mix.columnIndexMap[0], controlMask, inversionMask);
+        elements = conjugate(deque<ReverseElement>{ element }, elements);
     }
 
-    return transposed;
+    return elements;
 }
 
-deque<ReverseElement> PartialGtGenerator::removeColumnsCopies(const vector<word>& transposedMatrix, uint k,
-    MatrixMix* output, word* inversionMask) const
+template<typename ColumnType>
+deque<ReverseElement> PartialGtGenerator::removeColumnsCopies(const vector<ColumnType>& transposedMatrix,
+    uint k, MatrixMix* output, vector<ColumnType>* columns, word* inversionMask) const
 {
-    assertd(output && inversionMask, string("removeColumnsCopies(): null ptr"));
+    assertd(output && columns && inversionMask, string("removeColumnsCopies(): null ptr"));
 
     // 1) find unique columns
     uint columnCount = transposedMatrix.size();
-    unordered_map<word, list<uint>> columnToIndicesMap;
+    unordered_map<ColumnType, list<uint>> columnToIndicesMap;
 
     for (uint index = 0; index < columnCount; ++index)
     {
@@ -800,12 +886,14 @@ deque<ReverseElement> PartialGtGenerator::removeColumnsCopies(const vector<word>
 
     // 2) remove copies
     deque<ReverseElement> elements;
-    unordered_set<word> visited;
+    unordered_set<ColumnType> visited;
+
+    const ColumnType zero = BitVectorTraits<ColumnType>::create(k);
+    const ColumnType mask = BitVectorTraits<ColumnType>::createMask(k);
 
-    word mask = (1 << k) - 1;
     for (const auto& iter : columnToIndicesMap)
     {
-        word column = iter.first;
+        const ColumnType& column = iter.first;
         if (visited.find(column) != visited.cend())
             continue;
 
@@ -814,7 +902,7 @@ deque<ReverseElement> PartialGtGenerator::removeColumnsCopies(const vector<word>
 
         const list<uint>& indices = iter.second;
 
-        if (column == 0)
+        if (column == zero)
         {
             for (auto index : indices)
                 *inversionMask |= (word)1 << index;
@@ -823,7 +911,7 @@ deque<ReverseElement> PartialGtGenerator::removeColumnsCopies(const vector<word>
         }
 
         // complementary column
-        word complementaryColumn = ~column & mask;
+        ColumnType complementaryColumn = ~column & mask;
         if (columnToIndicesMap.find(complementaryColumn) != columnToIndicesMap.cend())
         {
             const list<uint>& complementaryIndices = columnToIndicesMap[complementaryColumn];
@@ -831,14 +919,14 @@ deque<ReverseElement> PartialGtGenerator::removeColumnsCopies(const vector<word>
 
             for (auto citer = ++indices.cbegin(); citer != indices.cend(); ++citer)
             {
-                ReverseElement element(n, 1 << *citer, 1 << *(complementaryIndices.cbegin()));
+                ReverseElement element(n, (word)1 << *citer, (word)1 << *(complementaryIndices.cbegin()));
                 elements.push_back(element);
             }
 
             for (auto citer = complementaryIndices.cbegin();
                 citer != complementaryIndices.cend(); ++citer)
             {
-                ReverseElement element(n, 1 << *citer, 1 << *(indices.cbegin()));
+                ReverseElement element(n, (word)1 << *citer, (word)1 << *(indices.cbegin()));
                 elements.push_back(element);
             }
         }
@@ -846,15 +934,15 @@ deque<ReverseElement> PartialGtGenerator::removeColumnsCopies(const vector<word>
         {
             for (auto citer = ++indices.cbegin(); citer != indices.cend(); ++citer)
             {
-                ReverseElement element(n, 1 << *citer, 1 << *(indices.cbegin()));
+                ReverseElement element(n, (word)1 << *citer, (word)1 << *(indices.cbegin()));
                 elements.push_back(element);
 
                 *inversionMask |= (word)1 << *citer;
             }
         }
 
-        output->columns.push_back(column);
-        output->columnIndexMap[output->columns.size() - 1] = *(indices.cbegin());
+        columns->push_back(column);
+        output->columnIndexMap[columns->size() - 1] = *(indices.cbegin());
 
         visited.insert(column);
     }
@@ -862,12 +950,16 @@ deque<ReverseElement> PartialGtGenerator::removeColumnsCopies(const vector<word>
     return elements;
 }
 
-PartialGtGenerator::MatrixMix PartialGtGenerator::reorderMatrixColumns(const MatrixMix& mix, uint k) const
+template<typename ColumnType>
+PartialGtGenerator::MatrixMix PartialGtGenerator::reorderMatrixColumns(const vector<ColumnType>& columns,
+    const MatrixMix& mix, uint k) const
 {
-    uint m = mix.columns.size();
+    uint m = columns.size();
 
     MatrixMix outputMix;
-    outputMix.columns.reserve(m);
+
+    vector<ColumnType> outputColumns;
+    outputColumns.reserve(m);
 
     struct Key
     {
@@ -879,9 +971,9 @@ PartialGtGenerator::MatrixMix PartialGtGenerator::reorderMatrixColumns(const Mat
     keys.reserve(m);
 
     uint index = 0;
-    for (auto column : mix.columns)
+    for (const auto& column : columns)
     {
-        uint weight = countNonZeroBits(column);
+        uint weight = BitVectorTraits<ColumnType>::countNonZeroBits(column);
         int dist = abs((int)(k / 2 - weight));
 
         keys.push_back( { index, dist } );
@@ -900,12 +992,12 @@ PartialGtGenerator::MatrixMix PartialGtGenerator::reorderMatrixColumns(const Mat
     {
         uint columnIndex = keys[index].index;
 
-        outputMix.columns.push_back(mix.columns[columnIndex]);
+        outputColumns.push_back(columns[columnIndex]);
         outputMix.columnIndexMap[index] = mix.columnIndexMap.at(columnIndex);
     }
 
     // make matrix from columns
-    outputMix.matrix = transposeMatrix(outputMix.columns, k);
+    outputMix.matrix = BitMatrixUtils::transpose<word>(outputColumns, k);
 
     return outputMix;
 }
@@ -921,7 +1013,7 @@ deque<ReverseElement> PartialGtGenerator::transformMatrixToCanonicalForm(MatrixM
     assertd(countNonZeroBits(k) == 1,
         string("transformMatrixToCanonicalForm(): only power of 2 is allowed for vector count"));
 
-    uint baseVectorCount = (uint)(log(k) / log(2));
+    uint baseVectorCount = findPositiveBitPosition(k);
     assert(baseVectorCount <= matrixWidth, string("transformMatrixToCanonicalForm(): wrong base vector count"));
 
     if (baseVectorCount == matrixWidth)
@@ -940,7 +1032,7 @@ deque<ReverseElement> PartialGtGenerator::transformMatrixToCanonicalForm(MatrixM
                 if (forbiddenIndices.find(index) != forbiddenIndices.cend())
                     continue;
 
-                elements.push_back(ReverseElement(n, 1 << index));
+                elements.push_back(ReverseElement(n, (word)1 << index));
                 firstInversionPos = index;
                 
                 break;
@@ -961,7 +1053,7 @@ deque<ReverseElement> PartialGtGenerator::transformMatrixToCanonicalForm(MatrixM
     }
 
     // transformation itself
-    uint baseMask = (1 << baseVectorCount) - 1;
+    word baseMask = ((word)1 << baseVectorCount) - 1;
     for (uint index = 0; index < k; index += 2)
     {
         uint xIndex = uintUndefined;
@@ -1060,7 +1152,7 @@ deque<ReverseElement> PartialGtGenerator::transformRowToCanonicalForm(MatrixMix*
     assertd(mix, string("transformRowToCanonicalForm(): null ptr"));
     assertd(rowIndex < mix->matrix.size(), string("transformRowToCanonicalForm(): invalid index parameter"));
 
-    word baseMask = (1 << baseVectorCount) - 1;
+    word baseMask = ((word)1 << baseVectorCount) - 1;
 
     word row = mix->matrix[rowIndex];
     word baseDiff = (canonicalForm ^ row) & baseMask;
@@ -1079,7 +1171,7 @@ deque<ReverseElement> PartialGtGenerator::transformRowToCanonicalForm(MatrixMix*
         // 3) make non-zero element from first non-basis column
         firstNonZeroElementPos = baseVectorCount;
 
-        word targetMask = 1 << firstNonZeroElementPos;
+        word targetMask = (word)1 << firstNonZeroElementPos;
         word controlMask = row & baseMask;
 
         ReverseElement element(n, getRealMask(mix, targetMask), getRealMask(mix, controlMask));
@@ -1094,13 +1186,13 @@ deque<ReverseElement> PartialGtGenerator::transformRowToCanonicalForm(MatrixMix*
         if (diff & ((word)1 << firstNonZeroElementPos))
             diff ^= (word)1 << firstNonZeroElementPos;
 
-        uint mask = 1;
-        while (mask <= diff)
+        word mask = 1;
+        while (mask && mask <= diff)
         {
             if (diff & mask)
             {
                 word targetMask = mask;
-                word controlMask = 1 << firstNonZeroElementPos;
+                word controlMask = (word)1 << firstNonZeroElementPos;
 
                 ReverseElement element(n, getRealMask(mix, targetMask), getRealMask(mix, controlMask));
                 elements.push_back(element);
@@ -1114,7 +1206,7 @@ deque<ReverseElement> PartialGtGenerator::transformRowToCanonicalForm(MatrixMix*
 
     // 5) remove non-zero element not from basis columns (== make canonical form)
     {
-        word targetMask = 1 << firstNonZeroElementPos;
+        word targetMask = (word)1 << firstNonZeroElementPos;
         word controlMask = canonicalForm;
 
         ReverseElement element(n, getRealMask(mix, targetMask), getRealMask(mix, controlMask));
@@ -1149,7 +1241,7 @@ word PartialGtGenerator::getRealMask(MatrixMix* mix, word inputMask) const
     word mask = 1;
     word index = 0;
 
-    while (mask <= inputMask)
+    while (mask && mask <= inputMask)
     {
         if (inputMask & mask)
             realMask |= (word)1 << (mix->columnIndexMap[index]);
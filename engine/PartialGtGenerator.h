@@ -28,10 +28,32 @@ namespace ReversibleLogic
 class PartialGtGenerator
 {
 public:
-    PartialGtGenerator(uint packSize = uintUndefined);
+    /// Snapshot of program options, which are used on each reduction step
+    struct Options
+    {
+        uint maxPackSize = uintUndefined;
+
+        bool isResultComparisonNeeded = false;
+        bool sortByWeightNotFrequency = false;
+        bool searchForBooleanEdges = true;
+        bool reversePackOrder = true;
+
+        /// Reads options from ProgramOptions, @packSize overrides transpositions pack size
+        static Options load(uint packSize = uintUndefined);
+    };
+
+    /// All transpositions of partial result are stored in @arena,
+    /// so it should not be reset while this generator is in use
+    explicit PartialGtGenerator(TranspositionArena* arena, uint packSize = uintUndefined);
+    PartialGtGenerator(TranspositionArena* arena, const Options& theOptions);
     virtual ~PartialGtGenerator() = default;
 
+    /// Generator could be reused with another arena on next reduction step,
+    /// scratch buffers of previous steps are kept
+    void setArena(TranspositionArena* theArena);
+
     void setPermutation(const Permutation& thePermutation, uint inputCount);
+    void setPermutation(Permutation&& thePermutation, uint inputCount);
     const Permutation& getPermutation() const;
 
     bool isLeftAndRightMultiplicationDiffers() const;
@@ -47,20 +69,20 @@ public:
     deque<ReverseElement> implementPartialResult();
 
 private:
-    PartialResultParams getPartialResult(shared_ptr<list<Transposition>> transpositions,
+    PartialResultParams getPartialResult(const TranspositionSpan& transpositions,
         word diff, const PartialResultParams& bestParams);
 
-    shared_ptr<list<Transposition>> getTranspositionsPack(const unordered_map<word, uint>& frequencyMap);
-    void getTranspositionsPack(shared_ptr<list<Transposition>> result, Permutation* permCopy,
-        unordered_set<word>* visited, bool reverseOrder);
+    /// Selects independent transpositions, which could be implemented at once
+    /// @diffs - all diffs of permutation in order of preference
+    TranspositionSpan getTranspositionsPack(const vector<word>& diffs);
 
-    shared_ptr<list<Transposition>> getCommonPair();
+    TranspositionSpan getCommonPair();
 
-    shared_ptr<list<Transposition>> findBestCandidates(shared_ptr<list<Transposition>> candidates);
-    void sortCandidates(shared_ptr<list<Transposition>> candidates);
+    TranspositionSpan findBestCandidates(const TranspositionSpan& candidates);
+    void sortCandidates(const TranspositionSpan& candidates);
 
     tuple<Transposition, uint>
-        findBestCandidatePartner(const shared_ptr<list<Transposition>> candidates,
+        findBestCandidatePartner(const TranspositionSpan& candidates,
         const Transposition& target);
 
     deque<ReverseElement> implementEdge();
@@ -68,23 +90,27 @@ private:
     deque<ReverseElement> implementSingleTransposition(const Transposition& transp);
     
     /// Implement multiple independent transpositions as one k-CNOT and many CNOT gates
-    deque<ReverseElement> implementIndependentTranspositions(shared_ptr<list<Transposition>> transp);
+    deque<ReverseElement> implementIndependentTranspositions(const TranspositionSpan& transp);
 
-    vector<word> transposeMatrix(const vector<word>& matrix, uint m) const;
+    /// Same as above for matrix of k rows (x1, y1, x2, y2, ...) with n bits in each row
+    /// ColumnType should be able to store k bits (word, WideWord or DynamicWord)
+    template<typename ColumnType>
+    deque<ReverseElement> implementIndependentTranspositions(const vector<word>& matrix);
 
     struct MatrixMix
     {
         vector<word> matrix; //new matrix after mix
-        vector<word> columns; //new columns of this matrix
         unordered_map<uint, uint> columnIndexMap; //index mapping for original matrix
     };
 
     /// Removes copies of columns in matrix
-    deque<ReverseElement> removeColumnsCopies(const vector<word>& transposedMatrix, uint k,
-        MatrixMix* output, word* inversionMask) const;
+    template<typename ColumnType>
+    deque<ReverseElement> removeColumnsCopies(const vector<ColumnType>& transposedMatrix, uint k,
+        MatrixMix* output, vector<ColumnType>* columns, word* inversionMask) const;
 
     /// Columns with weight close to k / 2 go first
-    MatrixMix reorderMatrixColumns(const MatrixMix& mix, uint k) const;
+    template<typename ColumnType>
+    MatrixMix reorderMatrixColumns(const vector<ColumnType>& columns, const MatrixMix& mix, uint k) const;
 
     /// Make canonical form of matrix
     deque<ReverseElement> transformMatrixToCanonicalForm(MatrixMix* mix, uint matrixWidth,
@@ -105,7 +131,30 @@ private:
 
     PartialResultParams partialResultParams;
 
-    uint maxPackSize;
+    Options options;
+    TranspositionArena* arena;
+
+    struct ElementLocation
+    {
+        word element;
+        uint cycleIndex;
+        uint position;
+    };
+
+    /// Transposition as chord of cycle
+    struct Chord
+    {
+        uint cycleIndex;
+        uint first;  //position of x in cycle
+        uint second; //position of y in cycle
+    };
+
+    // scratch buffers, cleared on each use but memory is kept between reduction steps
+    unordered_map<word, uint> frequencyMap;
+    vector<word> keys;
+    vector<ElementLocation> locations;
+    vector<word> visited;
+    vector<Chord> chords;
 };
 
 } //namespace ReversibleLogic
\ No newline at end of file
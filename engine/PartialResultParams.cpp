@@ -23,7 +23,7 @@
 PartialResultParams::PartialResultParams()
     : type(tNone)
     , distancesSum(0)
-    , transpositions(0)
+    , transpositions()
     , edge(uintUndefined)
 {
     memset(&params, 0, sizeof(params));
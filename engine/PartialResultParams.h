@@ -43,7 +43,8 @@ struct PartialResultParams
     PartialResultType type;
     uint distancesSum;
 
-    shared_ptr<list<ReversibleLogic::Transposition>> transpositions;
+    /// View into TranspositionArena of the generator, which produced this result
+    ReversibleLogic::TranspositionSpan transpositions;
     BooleanEdge edge;
 
     struct
@@ -29,7 +29,7 @@ Permutation::Permutation()
 }
 
 Permutation::Permutation(vector<shared_ptr<Cycle>> theCycles)
-    : cycles(theCycles)
+    : cycles(move(theCycles))
 {
 }
 
@@ -188,13 +188,7 @@ vector<shared_ptr<Cycle>>::const_iterator Permutation::end() const
     return cycles.cend();
 }
 
-Permutation Permutation::multiplyByTranspositions(
-    shared_ptr<list<Transposition>> transpositions, bool isLeftMultiplication) const
-{
-    return multiplyByTranspositions(*transpositions, isLeftMultiplication);
-}
-
-ReversibleLogic::Permutation Permutation::multiplyByTranspositions(const list<Transposition>& transpositions,
+ReversibleLogic::Permutation Permutation::multiplyByTranspositions(const TranspositionSpan& transpositions,
     bool isLeftMultiplication) const
 {
     vector<shared_ptr<Cycle>> newCycles;
@@ -240,8 +234,8 @@ ReversibleLogic::Permutation Permutation::multiplyByTranspositions(const list<Tr
                 {
                     // multiply in reverse order for tCommonPair--tPack cases
                     // for other cases this reverse order won't affect on result
-                    for (auto iter = transpositions.crbegin(); iter != transpositions.crend(); ++iter)
-                        y = iter->getOutput(y);
+                    for (uint index = transpositions.size(); index > 0; --index)
+                        y = transpositions[index - 1].getOutput(y);
 
                     for (auto cycle : *this)
                         y = cycle->getOutput(y);
@@ -253,8 +247,8 @@ ReversibleLogic::Permutation Permutation::multiplyByTranspositions(const list<Tr
 
                     // multiply in reverse order for tCommonPair--tPack cases
                     // for other cases this reverse order won't affect on result
-                    for (auto iter = transpositions.crbegin(); iter != transpositions.crend(); ++iter)
-                        y = iter->getOutput(y);
+                    for (uint index = transpositions.size(); index > 0; --index)
+                        y = transpositions[index - 1].getOutput(y);
                 }
 
                 if (nextCycle->isEmpty())
@@ -278,7 +272,7 @@ ReversibleLogic::Permutation Permutation::multiplyByTranspositions(const list<Tr
     assertd(!nextCycle->length(),
         string("Permutation::multiplyByTranspositions() failed because of last cycle"));
 
-    Permutation result(newCycles);
+    Permutation result(move(newCycles));
     return result;
 }
 
@@ -30,6 +30,12 @@ public:
     explicit Permutation(vector<shared_ptr<Cycle>> theCycles);
     virtual ~Permutation() = default;
 
+    Permutation(const Permutation&) = default;
+    Permutation(Permutation&&) = default;
+
+    Permutation& operator=(const Permutation&) = default;
+    Permutation& operator=(Permutation&&) = default;
+
     void append(shared_ptr<Cycle> cycle);
 
     uint length() const;
@@ -51,10 +57,7 @@ public:
     vector<shared_ptr<Cycle>>::const_iterator begin() const;
     vector<shared_ptr<Cycle>>::const_iterator end() const;
 
-    Permutation multiplyByTranspositions(shared_ptr<list<Transposition>> transpositions,
-        bool isLeftMultiplication) const;
-
-    Permutation multiplyByTranspositions(const list<Transposition>& transpositions,
+    Permutation multiplyByTranspositions(const TranspositionSpan& transpositions,
         bool isLeftMultiplication) const;
 
     uint getDistancesSum() const;
@@ -23,7 +23,8 @@
 namespace ReversibleLogic
 {
 
-Permutation PermutationUtils::createPermutation(const TruthTable& table,
+template<typename Entry>
+Permutation PermutationUtils::createPermutation(const BasicTruthTable<Entry>& table,
     bool permutationShouldBeEven /*= true*/)
 {
     vector<Piece> pieces = findPieces(table);
@@ -53,21 +54,24 @@ Permutation PermutationUtils::createPermutation(const TruthTable& table,
     return permutation;
 }
 
-vector<PermutationUtils::Piece> PermutationUtils::findPieces(const TruthTable& inputTable)
+template<typename Entry>
+vector<PermutationUtils::Piece> PermutationUtils::findPieces(const BasicTruthTable<Entry>& inputTable)
 {
-    TruthTable table = inputTable;
+    const Entry entryUndefined = numeric_limits<Entry>::max();
+
+    BasicTruthTable<Entry> table = inputTable;
     vector<Piece> pieces;
 
     uint transformCount = table.size();
     for(word x = 0; x < transformCount; ++x)
     {
-        word& y = table[x];
-        if(y == wordUndefined)
+        Entry& y = table[x];
+        if(y == entryUndefined)
             continue;
 
         if(x == y)
         {
-            y = wordUndefined;
+            y = entryUndefined;
             continue;
         }
 
@@ -78,12 +82,12 @@ vector<PermutationUtils::Piece> PermutationUtils::findPieces(const TruthTable& i
         while(z != x)
         {
             assertd(z < transformCount, string("Too big index"));
-            word& temp = table[z];
+            Entry& temp = table[z];
 
             ++length;
             assertd(length < transformCount, string("Too big piece"));
 
-            if(temp != z && temp != wordUndefined)
+            if(temp != z && temp != entryUndefined)
                 z = temp;
             else
                 break;
@@ -105,22 +109,22 @@ vector<PermutationUtils::Piece> PermutationUtils::findPieces(const TruthTable& i
         {
             piece[index] = z;
 
-            word& temp = table[z];
-            if(temp != z && temp != wordUndefined)
+            Entry& temp = table[z];
+            if(temp != z && temp != entryUndefined)
             {
                 z = temp;
-                temp = wordUndefined;
+                temp = entryUndefined;
 
                 ++index;
             }
             else
             {
-                temp = wordUndefined;
+                temp = entryUndefined;
                 break;
             }
         }
 
-        y = wordUndefined;
+        y = entryUndefined;
     }
 
     return pieces;
@@ -206,4 +210,14 @@ vector<PermutationUtils::Piece> PermutationUtils::mergePieces(const vector<Piece
     return outputCycles;
 }
 
+// packed truth tables, word is one of these types
+#define INSTANTIATE_PERMUTATION_UTILS(Entry) \
+    template Permutation PermutationUtils::createPermutation(const BasicTruthTable<Entry>&, bool);
+
+INSTANTIATE_PERMUTATION_UTILS(uint16_t)
+INSTANTIATE_PERMUTATION_UTILS(uint32_t)
+INSTANTIATE_PERMUTATION_UTILS(uint64_t)
+
+#undef INSTANTIATE_PERMUTATION_UTILS
+
 }   // namespace ReversibleLogic
@@ -28,11 +28,14 @@ class PermutationUtils
 public:
     typedef vector<word> Piece;
 
-    static Permutation createPermutation(const TruthTable& inputTable,
+    template<typename Entry>
+    static Permutation createPermutation(const BasicTruthTable<Entry>& inputTable,
         bool permutationShouldBeEven = true);
 
 private:
-    static vector<Piece> findPieces(const TruthTable& table);
+    /// Maximal value of @Entry type marks processed entries, so it shouldn't be in table
+    template<typename Entry>
+    static vector<Piece> findPieces(const BasicTruthTable<Entry>& table);
     static vector<Piece> mergePieces(const vector<Piece>& pieces);
 };
 
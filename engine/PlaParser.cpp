@@ -0,0 +1,286 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+PlaParser::Cube::Cube(uint n)
+    : edge(n)
+    , outputMask(0)
+{
+}
+
+void PlaParser::parse(istream& input)
+{
+    inputCount = 0;
+    outputCount = 0;
+    exclusiveSum = false;
+    cubes.clear();
+
+    string line;
+
+    try
+    {
+        while (getline(input, line))
+        {
+            // strip comment and trailing spaces (including CR)
+            size_t commentPosition = line.find('#');
+            if (commentPosition != string::npos)
+                line.resize(commentPosition);
+
+            while (!line.empty() && isspace((unsigned char)line.back()))
+                line.pop_back();
+
+            size_t position = line.find_first_not_of(" \t");
+            if (position == string::npos)
+                continue;
+
+            if (line[position] != '.')
+            {
+                parseCube(line);
+                continue;
+            }
+
+            istringstream lineStream(line);
+            string keyword;
+            lineStream >> keyword;
+
+            if (keyword == ".i")
+            {
+                lineStream >> inputCount;
+                assertFormat(!lineStream.fail() && inputCount > 0);
+            }
+            else if (keyword == ".o")
+            {
+                lineStream >> outputCount;
+                assertFormat(!lineStream.fail() && outputCount > 0);
+            }
+            else if (keyword == ".type")
+            {
+                string type;
+                lineStream >> type;
+                exclusiveSum = (type == "esop");
+            }
+            else if (keyword == ".e" || keyword == ".end")
+                break;
+
+            // .p, .ilb, .ob and other keywords don't change the function
+        }
+
+        assertFormat(inputCount && outputCount);
+    }
+    catch (InvalidFormatException& ex)
+    {
+        ostringstream errorStream;
+        errorStream << "Error: invalid line in PLA file:\n" << line;
+
+        ex.setMessage(errorStream.str());
+        throw ex;
+    }
+
+    assert(inputCount + outputCount <= sizeof(word) * 8,
+        string("PLA function has too many inputs and outputs for scheme lines"));
+}
+
+void PlaParser::parse(const string& fileName)
+{
+    ifstream input(fileName);
+    assert(input.is_open(),
+        string("Failed to open PLA file \"") + fileName + "\" for reading");
+
+    parse(input);
+}
+
+void PlaParser::parseCube(const string& line)
+{
+    // cube line is allowed only after .i and .o keywords
+    assertFormat(inputCount && outputCount);
+
+    Cube cube(inputCount);
+    cube.edge.baseValue = 0;
+    cube.edge.starsMask = 0;
+
+    uint position = 0;
+    for (char symbol : line)
+    {
+        if (isspace((unsigned char)symbol))
+            continue;
+
+        assertFormat(position < inputCount + outputCount);
+
+        if (position < inputCount)
+        {
+            word mask = (word)1 << (inputCount - 1 - position);
+            if (symbol == '1')
+                cube.edge.baseValue |= mask;
+            else if (symbol == '-')
+                cube.edge.starsMask |= mask;
+            else
+                assertFormat(symbol == '0');
+        }
+        else
+        {
+            word mask = (word)1 << (inputCount + outputCount - 1 - position);
+            if (symbol == '1')
+                cube.outputMask |= mask;
+            else
+                assertFormat(symbol == '0' || symbol == '-' || symbol == '~');
+        }
+
+        ++position;
+    }
+
+    assertFormat(position == inputCount + outputCount);
+
+    cube.edge.full = (cube.edge.starsMask == getFullMask(inputCount));
+    if (cube.outputMask)
+        cubes.push_back(cube);
+}
+
+uint PlaParser::getInputCount() const
+{
+    return inputCount;
+}
+
+uint PlaParser::getOutputCount() const
+{
+    return outputCount;
+}
+
+bool PlaParser::isExclusiveSumOfProducts() const
+{
+    return exclusiveSum;
+}
+
+const vector<PlaParser::Cube>& PlaParser::getCubes() const
+{
+    return cubes;
+}
+
+vector<BooleanEdge> PlaParser::getCoordinateEdges(uint output) const
+{
+    word outputMask = (word)1 << output;
+
+    vector<BooleanEdge> edges;
+    vector<BooleanEdge> covered;
+    vector<BooleanEdge> pieces;
+    vector<BooleanEdge> nextPieces;
+
+    for (auto& cube : cubes)
+    {
+        if (!(cube.outputMask & outputMask))
+            continue;
+
+        if (exclusiveSum)
+        {
+            edges.push_back(cube.edge);
+            continue;
+        }
+
+        // sum of products: only part of cube, which is not covered by previous
+        // cubes yet, is added, so exclusive sum of edges is equal to sum of cubes;
+        // previous cubes are subtracted instead of their pieces, because
+        // there are much less of them
+        pieces.assign(1, cube.edge);
+
+        for (auto& edge : covered)
+        {
+            if (!isIntersected(cube.edge, edge))
+                continue;
+
+            nextPieces.clear();
+            for (auto& piece : pieces)
+                subtractEdge(piece, edge, &nextPieces);
+
+            pieces.swap(nextPieces);
+            if (pieces.empty())
+                break;
+        }
+
+        edges.insert(edges.end(), pieces.cbegin(), pieces.cend());
+        covered.push_back(cube.edge);
+    }
+
+    return edges;
+}
+
+word PlaParser::getValue(word x) const
+{
+    word value = 0;
+    for (auto& cube : cubes)
+    {
+        if (cube.edge.has(x))
+        {
+            if (exclusiveSum)
+                value ^= cube.outputMask;
+            else
+                value |= cube.outputMask;
+        }
+    }
+
+    return value;
+}
+
+//static
+void PlaParser::subtractEdge(const BooleanEdge& edge, const BooleanEdge& subtrahend,
+    vector<BooleanEdge>* result)
+{
+    assertd(result, string("PlaParser::subtractEdge(): null ptr"));
+
+    word subtrahendMask = subtrahend.getBaseMask();
+
+    if (!isIntersected(edge, subtrahend))
+    {
+        result->push_back(edge);
+        return;
+    }
+
+    // fix stars of edge one by one: the value, which differs from subtrahend,
+    // gives next piece, the same value leads to the rest of intersection
+    word freeMask = edge.starsMask & subtrahendMask;
+
+    BooleanEdge rest = edge;
+    rest.full = false;
+
+    while (freeMask)
+    {
+        word mask = freeMask & ~(freeMask - 1);
+        freeMask ^= mask;
+
+        rest.starsMask ^= mask;
+
+        BooleanEdge piece = rest;
+        piece.baseValue |= ~subtrahend.baseValue & mask;
+        result->push_back(piece);
+
+        rest.baseValue |= subtrahend.baseValue & mask;
+    }
+}
+
+//static
+bool PlaParser::isIntersected(const BooleanEdge& left, const BooleanEdge& right)
+{
+    word mask = left.getBaseMask() & right.getBaseMask();
+    return ((left.baseValue ^ right.baseValue) & mask) == 0;
+}
+
+} //namespace ReversibleLogic
@@ -0,0 +1,79 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Parser of functions in PLA format (cube lists of espresso).
+/// Cubes are not expanded to truth table: each cube is kept as boolean edge
+/// (ones of cube are base value, dashes are stars) with mask of outputs, which contain it.
+/// As in text truth tables, the leftmost column of cube is the highest bit.
+/// Cover is treated as sum of products (on-set only, "0" and "-" outputs are zeros),
+/// or as exclusive sum of products for ".type esop".
+class PlaParser
+{
+public:
+    struct Cube
+    {
+        explicit Cube(uint n);
+
+        BooleanEdge edge;
+        word outputMask;
+    };
+
+    PlaParser() = default;
+    virtual ~PlaParser() = default;
+
+    void parse(istream& input);
+    void parse(const string& fileName);
+
+    uint getInputCount() const;
+    uint getOutputCount() const;
+
+    bool isExclusiveSumOfProducts() const;
+
+    const vector<Cube>& getCubes() const;
+
+    /// Returns edges, whose exclusive sum is the @output coordinate function
+    /// (cubes of sum of products are made disjoint)
+    vector<BooleanEdge> getCoordinateEdges(uint output) const;
+
+    /// Returns value of function on input @x, computed from cover
+    word getValue(word x) const;
+
+private:
+    void parseCube(const string& line);
+
+    /// Subtracts @subtrahend from @edge, result is a list of disjoint edges
+    static void subtractEdge(const BooleanEdge& edge, const BooleanEdge& subtrahend,
+        vector<BooleanEdge>* result);
+
+    static bool isIntersected(const BooleanEdge& left, const BooleanEdge& right);
+
+    uint inputCount = 0;
+    uint outputCount = 0;
+    bool exclusiveSum = false;
+
+    vector<Cube> cubes;
+};
+
+} //namespace ReversibleLogic
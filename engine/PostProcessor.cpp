@@ -301,6 +301,223 @@ void swapPeresElements(const ReverseElement& left, const ReverseElement& right,
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+// Local lines functions
+//////////////////////////////////////////////////////////////////////////
+
+/// Expresses @element as gate on local lines, new lines are appended to @lines
+/// Returns false if element doesn't fit to TemplateLibrary::numLineCount local lines
+bool getLocalGate(const ReverseElement& element, word* lines, uint* lineCount,
+    TemplateLibrary::Gate* gate)
+{
+    word targetMask = element.getTargetMask();
+    if (!element.isIndependent() || countNonZeroBits(targetMask) != 1)
+        return false;
+
+    word inversionMask = element.getInversionMask();
+
+    uint count = *lineCount;
+    uint localTarget = 0;
+    uint localControlMask = 0;
+    uint localInversionMask = 0;
+
+    word elementMask = targetMask | element.getControlMask();
+    while (elementMask)
+    {
+        word mask = elementMask & (~elementMask + 1);
+        elementMask ^= mask;
+
+        uint line = 0;
+        while (line < count && lines[line] != mask)
+            ++line;
+
+        if (line == count)
+        {
+            if (count == TemplateLibrary::numLineCount)
+                return false;
+
+            lines[count++] = mask;
+        }
+
+        if (mask == targetMask)
+            localTarget = line;
+        else
+            localControlMask |= 1 << line;
+
+        if (inversionMask & mask)
+            localInversionMask |= 1 << line;
+    }
+
+    *lineCount = count;
+    *gate = TemplateLibrary::makeGate(localTarget, localControlMask, localInversionMask);
+
+    return true;
+}
+
+/// Returns index of the first element of the longest block of neighbor elements, which ends
+/// on @index and could be expressed as gates on TemplateLibrary::numLineCount local lines
+uint findLocalBlockStart(const vector<ReverseElement>& scheme, uint index)
+{
+    word lines = 0;
+    uint start = index + 1;
+
+    while (start > 0)
+    {
+        const ReverseElement& element = scheme[start - 1];
+        word targetMask = element.getTargetMask();
+
+        if (!element.isIndependent() || countNonZeroBits(targetMask) != 1)
+            break;
+
+        word blockLines = lines | targetMask | element.getControlMask();
+        if (countNonZeroBits(blockLines) > TemplateLibrary::numLineCount)
+            break;
+
+        lines = blockLines;
+        --start;
+    }
+
+    return min(start, index);
+}
+
+/// Converts @circuit on local @lines to elements and calculates their quantum cost
+/// Returns false if circuit uses lines out of @lineCount or not allowed inversions
+bool getElementsFromLocalGates(const vector<TemplateLibrary::Gate>& circuit, uint n,
+    const word* lines, uint lineCount, bool isNegativeControlInputsAllowed,
+    vector<ReverseElement>* elements, uint* cost)
+{
+    elements->clear();
+    *cost = 0;
+
+    for (auto gate : circuit)
+    {
+        uint target = TemplateLibrary::getTarget(gate);
+        uint controlMask = TemplateLibrary::getControlMask(gate);
+        uint inversionMask = TemplateLibrary::getInversionMask(gate);
+
+        if (target >= lineCount || controlMask >> lineCount ||
+            (inversionMask && !isNegativeControlInputsAllowed))
+        {
+            return false;
+        }
+
+        word newControlMask = 0;
+        word newInversionMask = 0;
+        for (uint line = 0; line < lineCount; ++line)
+        {
+            if (controlMask & (1 << line))
+                newControlMask |= lines[line];
+
+            if (inversionMask & (1 << line))
+                newInversionMask |= lines[line];
+        }
+
+        elements->push_back(ReverseElement(n, lines[target], newControlMask, newInversionMask));
+        *cost += SchemeUtils::getElementQuantumCost(elements->back());
+    }
+
+    return true;
+}
+
+/// Returns true if replacement of window by circuit with @cost and @size reduces
+/// quantum cost or number of elements more, than @bestCostGain and @bestSizeGain,
+/// which are updated in that case (both zero gains mean no replacement yet)
+bool isBetterReplacement(uint windowCost, uint windowSize, uint cost, uint size,
+    uint* bestCostGain, uint* bestSizeGain)
+{
+    if (cost > windowCost || size > windowSize)
+        return false;
+
+    uint costGain = windowCost - cost;
+    uint sizeGain = windowSize - size;
+    if (costGain < *bestCostGain || (costGain == *bestCostGain && sizeGain <= *bestSizeGain))
+        return false;
+
+    *bestCostGain = costGain;
+    *bestSizeGain = sizeGain;
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Changed ranges functions
+//////////////////////////////////////////////////////////////////////////
+
+/// Returns new position of @end, which is the end of range containing @position, after
+/// @oldCount elements starting from @position were replaced by @newCount elements;
+/// if range ends inside of replaced elements, it is extended to the end of replacement
+uint getShiftedEnd(uint end, uint position, uint oldCount, uint newCount)
+{
+    return (end >= position + oldCount ? end - oldCount + newCount : position + newCount);
+}
+
+/// Same as above for range [@first, @end) of changed elements, replacement is added to it
+/// Empty range has @first equal to uintUndefined
+void updateChangedRange(uint position, uint oldCount, uint newCount, uint* first, uint* end)
+{
+    if (*first == uintUndefined)
+    {
+        *first = position;
+        *end = position + newCount;
+        return;
+    }
+
+    *first = min(*first, position);
+    *end = getShiftedEnd(*end, position, oldCount, newCount);
+}
+
+/// Updates sorted disjoint @ranges after @oldCount elements starting from @position
+/// were replaced by @newCount elements, then adds range [@first, @last] to them
+void updateDirtyRanges(vector<Range>* ranges, uint position, uint oldCount, uint newCount,
+    uint first, uint last)
+{
+    vector<Range> result;
+    result.reserve(ranges->size() + 1);
+
+    // ranges are added in ascending order, overlapping and adjacent ones are merged
+    auto add = [&result](uint start, uint end)
+    {
+        if (!result.empty() && result.back().end + 1 >= start)
+            result.back().end = max(result.back().end, end);
+        else
+            result.push_back(Range{ start, end });
+    };
+
+    bool isAdded = false;
+    auto addPart = [&](uint start, uint end)
+    {
+        if (!isAdded && first <= start)
+        {
+            add(first, last);
+            isAdded = true;
+        }
+
+        add(start, end);
+    };
+
+    uint oldEnd = position + oldCount;
+    for (auto& range : *ranges)
+    {
+        if (range.end < position)
+            addPart(range.start, range.end);
+        else if (range.start >= oldEnd)
+            addPart(range.start - oldCount + newCount, range.end - oldCount + newCount);
+        else
+        {
+            // replaced part of range is covered by added range
+            if (range.start < position)
+                addPart(range.start, position - 1);
+
+            if (range.end >= oldEnd)
+                addPart(position + newCount, range.end - oldCount + newCount);
+        }
+    }
+
+    if (!isAdded)
+        add(first, last);
+
+    ranges->swap(result);
+}
+
 //////////////////////////////////////////////////////////////////////////
 ReversibleLogic::Scheme PostProcessor::optimize(const Scheme& scheme)
 {
@@ -325,82 +542,171 @@ PostProcessor::OptScheme PostProcessor::optimize(const OptScheme& scheme)
     if (!ProgramOptions::get().doPostOptimization)
         return scheme;
 
+    const ProgramOptions& options = ProgramOptions::get();
+    bool doFullSchemeOptimizations =
+        options.options.getBool("do-last-optimizations-with-full-scheme", true);
+    bool removeNegativeControlInputs =
+        options.options.getBool("remove-negative-control-inputs", false);
+
+    bool doDepthOptimization =
+        options.options.getBool("do-depth-optimization", false);
+
+    report = Report();
+    report.stageCount = (doDepthOptimization ? 3 : 2);
+    if (doFullSchemeOptimizations)
+        report.stageCount += (removeNegativeControlInputs ? 3 : 2);
+
+    timeOver = false;
+    hasDeadline = (options.postProcessingTimeLimit != 0);
+    if (hasDeadline)
+        deadline = chrono::steady_clock::now() + chrono::seconds(options.postProcessingTimeLimit);
+
     OptScheme optimizedScheme = scheme;
-    
-    uint lengthBefore = uintUndefined;
-    uint lengthAfter  = uintUndefined;
     isNegativeControlInputsAllowed = true;
 
-    bool needOptimization = true;
-    while(needOptimization)
+    if (startStage("merge"))
     {
-        optimizedScheme = removeDuplicates(optimizedScheme);
-        
-        needOptimization = false;
-        optimizedScheme = mergeOptimization(optimizedScheme, &needOptimization);
+        DirtyRegions regions(optimizedScheme.size());
+
+        bool needOptimization = true;
+        while (needOptimization && !isTimeOver())
+        {
+            removeDuplicates(&optimizedScheme, &regions);
+
+            needOptimization = false;
+            mergeOptimization(&optimizedScheme, &needOptimization, &regions);
+        }
     }
 
     // final implementation
     OptScheme implementation;
     implementation = optimizedScheme;
 
-    if (ProgramOptions::get().options.getBool("do-last-optimizations-with-full-scheme", true))
+    if (doFullSchemeOptimizations)
     {
+        // full scheme is more expensive until it is optimized, so if time is over
+        // during its optimization, the best of schemes before and after is taken
+        auto optimizeStage = [&](const char* name, FullSchemeType type)
+        {
+            if (!startStage(name))
+                return;
+
+            OptScheme fullScheme = optimizeFullScheme(implementation, type);
+            if (!isTimeOver() || SchemeUtils::calculateQuantumCost(fullScheme) <
+                SchemeUtils::calculateQuantumCost(implementation))
+                implementation.swap(fullScheme);
+        };
+
         isNegativeControlInputsAllowed = true;
+        optimizeStage("recursive full scheme", fstRecursive);
 
-        implementation = getFullScheme(implementation, fstRecursive);
-        implementation = removeDuplicates(implementation);
+        isNegativeControlInputsAllowed = true;
+        optimizeStage("simple full scheme", fstSimple);
 
-        needOptimization = true;
-        while (needOptimization)
+        if (removeNegativeControlInputs)
         {
-            needOptimization = false;
-            implementation = transferOptimization(implementation, &needOptimization);
+            isNegativeControlInputsAllowed = false;
 
-            bool additional = false;
-            implementation = mergeOptimization(implementation, &additional);
-            needOptimization = needOptimization || additional;
+            // negative control inputs are removed by decomposition itself,
+            // so it is done even if time is over
+            startStage("full scheme without negative control inputs");
+            implementation = optimizeFullScheme(implementation, fstSimple);
         }
+    }
 
-        isNegativeControlInputsAllowed = true;
+    if (startStage("Peres gates"))
+    {
+        // elements are left as is, only their quantum cost is changed
+        PassReport result;
+        result.quantumCostReduction = (int)SchemeUtils::calculateQuantumCost(implementation);
 
-        implementation = getFullScheme(implementation, fstSimple);
-        implementation = removeDuplicates(implementation);
+        peresGateOptimization(&implementation);
 
-        needOptimization = true;
-        while (needOptimization)
-        {
-            needOptimization = false;
-            implementation = transferOptimization(implementation, &needOptimization);
+        result.quantumCostReduction -= (int)SchemeUtils::calculateQuantumCost(implementation);
+        addPassResult(opPeres, result);
+    }
 
-            bool additional = false;
-            implementation = mergeOptimization(implementation, &additional);
-            needOptimization = needOptimization || additional;
-        }
+    if (doDepthOptimization && startStage("depth"))
+        implementation = depthOptimization(implementation);
 
-        if (ProgramOptions::get().options.getBool("remove-negative-control-inputs", false))
-        {
-            isNegativeControlInputsAllowed = false;
+    report.isInterrupted = timeOver;
+    return implementation;
+}
 
-            implementation = getFullScheme(implementation, fstSimple);
-            implementation = removeDuplicates(implementation);
+//static
+const char* PostProcessor::getPassName(OptimizationPass pass)
+{
+    static const char* names[] =
+    {
+        "duplicates",
+        "merge",
+        "transfer",
+        "template",
+        "resynthesis",
+        "Peres gates",
+    };
+
+    assertd(pass < opPassCount, string("PostProcessor::getPassName(): wrong pass"));
+    return names[pass];
+}
 
-            needOptimization = true;
-            while (needOptimization)
-            {
-                needOptimization = false;
-                implementation = transferOptimization(implementation, &needOptimization);
+const PostProcessor::Report& PostProcessor::getReport() const
+{
+    return report;
+}
 
-                bool additional = false;
-                implementation = mergeOptimization(implementation, &additional);
-                needOptimization = needOptimization || additional;
-            }
-        }
+void PostProcessor::logReport(ostream& out) const
+{
+    if (report.isInterrupted)
+        out << "Optimization is interrupted by time limit" << endl;
+
+    out << "Optimization stages: " << report.stages.size() << " of " << report.stageCount;
+    for (uint index = 0; index < report.stages.size(); ++index)
+        out << (index ? ", " : " (") << report.stages[index];
+
+    out << (report.stages.empty() ? "" : ")") << endl;
+
+    for (uint pass = 0; pass < opPassCount; ++pass)
+    {
+        const PassReport& passReport = report.passes[pass];
+        if (!passReport.runCount)
+            continue;
+
+        out << "Optimization pass \"" << getPassName((OptimizationPass)pass) << "\": ";
+        out << passReport.runCount << " runs, ";
+        out << "complexity reduction " << passReport.complexityReduction << ", ";
+        out << "quantum cost reduction " << passReport.quantumCostReduction << endl;
     }
+}
 
-    implementation = peresGateOptimization(implementation);
+bool PostProcessor::startStage(const char* name)
+{
+    if (isTimeOver())
+        return false;
 
-    return implementation;
+    report.stages.push_back(name);
+    return true;
+}
+
+bool PostProcessor::isTimeOver() const
+{
+    if (!hasDeadline)
+        return false;
+
+    if (!timeOver && chrono::steady_clock::now() >= deadline)
+        timeOver = true;
+
+    return timeOver;
+}
+
+void PostProcessor::addPassResult(OptimizationPass pass, const PassReport& result)
+{
+    lock_guard<mutex> lock(reportMutex);
+
+    PassReport& passReport = report.passes[pass];
+    ++passReport.runCount;
+    passReport.complexityReduction += result.complexityReduction;
+    passReport.quantumCostReduction += result.quantumCostReduction;
 }
 
 void PostProcessor::prepareSchemeForOptimization(const OptScheme& scheme,
@@ -504,116 +810,840 @@ PostProcessor::OptScheme PostProcessor::optimizeInversions(const OptScheme& sche
         }
     }
 
-    return applyOptimizations(scheme, optimizations);
+    return applyOptimizations(scheme, optimizations);
+}
+
+void PostProcessor::optimizeDirtyElements(OptScheme* scheme, DirtyRegions* regions)
+{
+    removeDuplicates(scheme, regions);
+
+    bool needOptimization = true;
+    while (needOptimization && !isTimeOver())
+    {
+        needOptimization = false;
+        transferOptimization(scheme, &needOptimization, regions);
+
+        bool additional = false;
+        mergeOptimization(scheme, &additional, regions);
+        needOptimization = needOptimization || additional;
+
+        additional = false;
+        templateOptimization(scheme, &additional, regions);
+        needOptimization = needOptimization || additional;
+
+        additional = false;
+        resynthesisOptimization(scheme, &additional, regions);
+        needOptimization = needOptimization || additional;
+    }
+}
+
+PostProcessor::OptScheme PostProcessor::optimizeFullScheme(const OptScheme& scheme,
+    FullSchemeType type)
+{
+    const uint windowSize = ProgramOptions::get().maxSubSchemeSizeForOptimization;
+    const uint maxDistance = ProgramOptions::get().maxElementsDistanceForOptimization;
+
+    // at most one decomposed window per thread exists at once
+    const uint batchSize = ThreadPool::get().getThreadCount();
+
+    // decomposed element takes several positions, so border is narrower than @maxDistance
+    uint elementCount = scheme.size();
+    uint windowCount = max((elementCount + windowSize - 1) / windowSize, 1u);
+    uint borderSize = min(maxDistance, windowSize) / 4;
+
+    // elements of @scheme near window borders are left as is in the first round,
+    // other elements of each window are decomposed and optimized separately
+    auto getWindowPart = [&](uint index, uint* first, uint* last)
+    {
+        *first = (index ? min(index * windowSize + borderSize, elementCount) : 0);
+        *last = (index + 1 < windowCount ? (index + 1) * windowSize - borderSize : elementCount);
+        *last = max(*last, *first);
+    };
+
+    // positions and sizes of elements near borders in the first round scheme
+    vector<pair<uint, uint>> borders;
+    vector<OptScheme> windows;
+
+    OptScheme implementation;
+    uint processedCount = 0;
+
+    for (uint batchStart = 0; batchStart < windowCount && !isTimeOver(); batchStart += batchSize)
+    {
+        uint count = min(batchSize, windowCount - batchStart);
+        windows.resize(count);
+
+        ThreadPool::get().parallelFor(count, [&](uint index)
+        {
+            uint first = 0;
+            uint last = 0;
+            getWindowPart(batchStart + index, &first, &last);
+
+            OptScheme& window = windows[index];
+            window = getFullScheme(OptScheme(scheme.cbegin() + first, scheme.cbegin() + last), type);
+
+            DirtyRegions regions(window.size());
+            optimizeDirtyElements(&window, &regions);
+        });
+
+        for (uint index = 0; index < count; ++index)
+        {
+            uint windowIndex = batchStart + index;
+            if (windowIndex)
+            {
+                uint first = windowIndex * windowSize - borderSize;
+                uint last = min(windowIndex * windowSize + borderSize, elementCount);
+
+                borders.push_back(make_pair((uint)implementation.size(), last - first));
+                implementation.insert(implementation.end(),
+                    scheme.cbegin() + first, scheme.cbegin() + last);
+            }
+
+            const OptScheme& window = windows[index];
+            implementation.insert(implementation.end(), window.cbegin(), window.cend());
+
+            uint first = 0;
+            getWindowPart(windowIndex, &first, &processedCount);
+        }
+    }
+
+    // negative control inputs are removed by decomposition, so windows skipped
+    // after time is over are decomposed without optimization
+    if (processedCount < elementCount)
+    {
+        OptScheme rest = getFullScheme(OptScheme(scheme.cbegin() + processedCount,
+            scheme.cend()), type);
+
+        implementation.insert(implementation.end(), rest.cbegin(), rest.cend());
+    }
+
+    if (borders.empty())
+        return implementation;
+
+    // elements near borders are decomposed and optimized together with optimized elements
+    // around them, pairs of elements inside of windows were examined before
+    OptScheme fullScheme;
+    DirtyRegions regions(0);
+    uint copiedCount = 0;
+
+    for (auto& border : borders)
+    {
+        fullScheme.insert(fullScheme.end(),
+            implementation.cbegin() + copiedCount, implementation.cbegin() + border.first);
+
+        copiedCount = border.first + border.second;
+        OptScheme decomposed = getFullScheme(OptScheme(implementation.cbegin() + border.first,
+            implementation.cbegin() + copiedCount), type);
+
+        uint position = fullScheme.size();
+        fullScheme.insert(fullScheme.end(), decomposed.cbegin(), decomposed.cend());
+
+        uint count = decomposed.size();
+        updateDirtyRegions(&regions, position, count, count, fullScheme.size());
+    }
+
+    fullScheme.insert(fullScheme.end(), implementation.cbegin() + copiedCount,
+        implementation.cend());
+
+    OptScheme().swap(implementation);
+    optimizeDirtyElements(&fullScheme, &regions);
+
+    return fullScheme;
+}
+
+PostProcessor::DirtyRegions::DirtyRegions(uint elementCount)
+{
+    if (!elementCount)
+        return;
+
+    for (auto& ranges : passes)
+        ranges.push_back(Range{ 0, elementCount - 1 });
+}
+
+//static
+void PostProcessor::updateDirtyRegions(DirtyRegions* regions, uint position, uint oldCount,
+    uint newCount, uint elementCount)
+{
+    if (!elementCount)
+    {
+        for (auto& ranges : regions->passes)
+            ranges.clear();
+
+        regions->changed.clear();
+        return;
+    }
+
+    // if elements are removed, pairs of their neighbors weren't examined yet
+    uint first = position;
+    uint last = position + newCount - 1;
+
+    if (!newCount)
+    {
+        first = (position ? position - 1 : 0);
+        last = min(position, elementCount - 1);
+    }
+
+    for (auto& ranges : regions->passes)
+        updateDirtyRanges(&ranges, position, oldCount, newCount, first, last);
+
+    updateDirtyRanges(&regions->changed, position, oldCount, newCount, first, last);
+}
+
+//static
+void PostProcessor::replaceElements(OptScheme* scheme, uint position, uint count,
+    OptScheme::const_iterator first, OptScheme::const_iterator last,
+    DirtyRegions* regions, PassReport* result)
+{
+    assertd(scheme && position + count <= scheme->size() && result,
+        string("Wrong params (PostProcessor::replaceElements)"));
+
+    uint newCount = (uint)(last - first);
+    OptScheme::iterator target = scheme->begin() + position;
+
+    result->complexityReduction += (int)count - (int)newCount;
+    for (auto element = target; element != target + count; ++element)
+        result->quantumCostReduction += SchemeUtils::getElementQuantumCost(*element);
+
+    for (auto element = first; element != last; ++element)
+        result->quantumCostReduction -= SchemeUtils::getElementQuantumCost(*element);
+
+    if (newCount < count)
+        target = scheme->erase(target, target + (count - newCount));
+    else if (newCount > count)
+        target = scheme->insert(target, newCount - count, ReverseElement());
+
+    copy(first, last, target);
+
+    if (regions)
+        updateDirtyRegions(regions, position, count, newCount, scheme->size());
+}
+
+void PostProcessor::removeDuplicates(OptScheme* scheme, DirtyRegions* regions /*= 0*/)
+{
+    // duplicates are always removed, so rewrites are never rolled back
+    bool optimized = false;
+    generalOptimization(scheme, &optimized, selectEqual, swapEqualElements,
+        false, false, true, regions, opDuplicates);
+}
+
+void PostProcessor::mergeOptimization(OptScheme* scheme, bool* optimized,
+    DirtyRegions* regions /*= 0*/)
+{
+    auto selectFunc = (
+        isNegativeControlInputsAllowed ?
+        selectForMergeOptimization :
+        selectForMergeOptimizationWithoutInversions
+    );
+
+    generalOptimization(scheme, optimized, selectFunc,
+        swapElementsWithMerge, false, false, true, regions, opMerge);
+}
+
+void PostProcessor::reduceConnectionsOptimization(OptScheme* scheme, bool* optimized)
+{
+    generalOptimization(scheme, optimized, selectForReduceConnectionsOptimization,
+        swapElementsWithConnectionReduction, false, false);
+}
+
+void PostProcessor::transferOptimization(OptScheme* scheme, bool* optimized,
+    DirtyRegions* regions /*= 0*/)
+{
+    generalOptimization(scheme, optimized, selectForTransferOptimization,
+        swapElementsWithTransferOptimization, false, true, true, regions, opTransfer);
+}
+
+void PostProcessor::peresGateOptimization(OptScheme* scheme)
+{
+    rewriteScheme(scheme, selectForPeresGateOptimization,
+        swapPeresElements, false, false, false);
+}
+
+PostProcessor::OptScheme PostProcessor::depthOptimization(const OptScheme& scheme)
+{
+    uint elementCount = scheme.size();
+    if (elementCount < 2)
+        return scheme;
+
+    // Peres gates are moved as one unit, otherwise quantum cost could increase
+    struct Unit
+    {
+        uint first;
+        uint size;
+        word lines;
+        uint layer;
+    };
+
+    vector<Unit> units;
+    units.reserve(elementCount);
+
+    vector<bool> peresGateFlags = SchemeUtils::getPeresGateFlags(scheme);
+    for (uint index = 0; index < elementCount; ++index)
+    {
+        if (peresGateFlags[index])
+        {
+            Unit& unit = units.back();
+            ++unit.size;
+            unit.lines |= SchemeUtils::getElementLines(scheme[index]);
+        }
+        else
+            units.push_back(Unit{ index, 1, SchemeUtils::getElementLines(scheme[index]), 0 });
+    }
+
+    auto isCommuting = [&](const Unit& left, const Unit& right) -> bool
+    {
+        if (!(left.lines & right.lines))
+            return true;
+
+        for (uint leftIndex = left.first; leftIndex < left.first + left.size; ++leftIndex)
+        {
+            const ReverseElement& leftElement = scheme[leftIndex];
+            if (!leftElement.isIndependent())
+                return false;
+
+            for (uint rightIndex = right.first; rightIndex < right.first + right.size; ++rightIndex)
+            {
+                const ReverseElement& rightElement = scheme[rightIndex];
+                if (!rightElement.isIndependent() || !leftElement.isSwappable(rightElement))
+                    return false;
+            }
+        }
+
+        return true;
+    };
+
+    // each unit is placed to the earliest free layer after all units it doesn't commute with,
+    // only last maxDistance units on each line are checked for commutation,
+    // older ones are considered as dependencies
+    const uint maxDistance = ProgramOptions::get().maxElementsDistanceForOptimization;
+    uint n = scheme.front().getInputCount();
+
+    vector<vector<uint>> lineUnits(n);
+    vector<uint> lineBounds(n, 0);
+    vector<vector<bool>> occupiedLayers(n);
+
+    uint unitCount = units.size();
+    for (uint unitIndex = 0; unitIndex < unitCount; ++unitIndex)
+    {
+        Unit& unit = units[unitIndex];
+
+        uint bound = 0;
+        for (uint line = 0; line < n; ++line)
+        {
+            if (!(unit.lines & ((word)1 << line)))
+                continue;
+
+            bound = max(bound, lineBounds[line]);
+
+            const vector<uint>& indices = lineUnits[line];
+            uint count = indices.size();
+            for (uint index = (count > maxDistance ? count - maxDistance : 0); index < count; ++index)
+            {
+                const Unit& another = units[indices[index]];
+                if (another.layer + another.size > bound && !isCommuting(another, unit))
+                    bound = another.layer + another.size;
+            }
+        }
+
+        uint layer = bound;
+        for (bool found = false; !found; )
+        {
+            found = true;
+            for (uint line = 0; line < n && found; ++line)
+            {
+                if (!(unit.lines & ((word)1 << line)))
+                    continue;
+
+                const vector<bool>& occupied = occupiedLayers[line];
+                for (uint offset = 0; offset < unit.size; ++offset)
+                {
+                    if (layer + offset < occupied.size() && occupied[layer + offset])
+                    {
+                        found = false;
+                        ++layer;
+                        break;
+                    }
+                }
+            }
+        }
+
+        unit.layer = layer;
+        for (uint line = 0; line < n; ++line)
+        {
+            if (!(unit.lines & ((word)1 << line)))
+                continue;
+
+            vector<bool>& occupied = occupiedLayers[line];
+            if (occupied.size() < layer + unit.size)
+                occupied.resize(layer + unit.size, false);
+
+            for (uint offset = 0; offset < unit.size; ++offset)
+                occupied[layer + offset] = true;
+
+            vector<uint>& indices = lineUnits[line];
+            indices.push_back(unitIndex);
+
+            if (indices.size() > maxDistance)
+            {
+                const Unit& old = units[indices[indices.size() - maxDistance - 1]];
+                lineBounds[line] = max(lineBounds[line], old.layer + old.size);
+            }
+        }
+    }
+
+    stable_sort(units.begin(), units.end(), [](const Unit& left, const Unit& right) -> bool
+    {
+        return left.layer < right.layer;
+    });
+
+    OptScheme optimizedScheme;
+    optimizedScheme.reserve(elementCount);
+
+    for (auto& unit : units)
+    {
+        for (uint index = unit.first; index < unit.first + unit.size; ++index)
+            optimizedScheme.push_back(scheme[index]);
+    }
+
+    // greedy scheduling doesn't guarantee improvement, so the best scheme is taken
+    if (SchemeUtils::calculateQuantumCost(optimizedScheme) > SchemeUtils::calculateQuantumCost(scheme) ||
+        SchemeUtils::calculateDepth(optimizedScheme) >= SchemeUtils::calculateDepth(scheme))
+    {
+        return scheme;
+    }
+
+    return optimizedScheme;
+}
+
+void PostProcessor::templateOptimization(OptScheme* scheme, bool* optimized,
+    DirtyRegions* regions /*= 0*/)
+{
+    assertd(optimized, string("Null 'optimized' pointer (PostProcessor::templateOptimization)"));
+
+    const TemplateLibrary& library = TemplateLibrary::get();
+    if (!library.isLoaded())
+        return;
+
+    OptScheme& elements = *scheme;
+    vector<ReverseElement> replacement;
+    PassReport result;
+
+    vector<Range> ranges;
+    if (regions)
+        ranges.swap(regions->passes[opTemplate]);
+    else if (!elements.empty())
+        ranges.push_back(Range{ 0, (uint)elements.size() - 1 });
+
+    // windows with dirty elements could start before them
+    const uint backStep = TemplateLibrary::numMaxWindowSize - 1;
+
+    // elements after examined ones are only shifted by replacements
+    int shift = 0;
+    uint examinedEnd = 0;
+
+    for (auto& range : ranges)
+    {
+        uint first = (uint)max((int)range.start + shift, (int)examinedEnd);
+        uint end = range.end + 1 + shift;
+        if (end <= examinedEnd)
+            continue;
+
+        uint index = max(first > backStep ? first - backStep : 0, examinedEnd);
+        while (index < end && !isTimeOver())
+        {
+            uint windowSize = 0;
+            if (!findTemplateReplacement(library, elements, index, &windowSize, &replacement))
+            {
+                ++index;
+                continue;
+            }
+
+            uint elementCount = elements.size();
+            replaceElements(&elements, index, windowSize,
+                replacement.cbegin(), replacement.cend(), regions, &result);
+
+            end = getShiftedEnd(end, index, windowSize, replacement.size());
+            shift += (int)elements.size() - (int)elementCount;
+
+            *optimized = true;
+
+            // windows, which end right after replacement, should be examined again
+            index = (index > backStep ? index - backStep : 0);
+        }
+
+        examinedEnd = end;
+    }
+
+    // replacements were examined above
+    if (regions)
+        regions->passes[opTemplate].clear();
+
+    addPassResult(opTemplate, result);
+}
+
+bool PostProcessor::findTemplateReplacement(const TemplateLibrary& library,
+    const OptScheme& scheme, uint startIndex, uint* windowSize, vector<ReverseElement>* replacement)
+{
+    assertd(windowSize && replacement,
+        string("PostProcessor::findTemplateReplacement(): null ptr"));
+
+    uint elementCount = scheme.size();
+    uint n = scheme[startIndex].getInputCount();
+
+    // lines of window in order of appearance, local line index is index in this array
+    word lines[TemplateLibrary::numLineCount];
+    uint lineCount = 0;
+
+    TemplateLibrary::TruthTable table = TemplateLibrary::getIdentity();
+    vector<TemplateLibrary::Gate> circuit;
+    vector<ReverseElement> candidate;
+
+    uint windowCost = 0;
+    uint bestCostGain = 0;
+    uint bestSizeGain = 0;
+    *windowSize = 0;
+
+    for (uint size = 1; size <= TemplateLibrary::numMaxWindowSize; ++size)
+    {
+        uint index = startIndex + size - 1;
+        if (index >= elementCount)
+            break;
+
+        const ReverseElement& element = scheme[index];
+
+        TemplateLibrary::Gate gate;
+        if (!getLocalGate(element, lines, &lineCount, &gate))
+            break;
+
+        table = TemplateLibrary::applyGate(table, gate);
+        windowCost += SchemeUtils::getElementQuantumCost(element);
+
+        if (size < 2 || !library.findCircuit(table, &circuit) || circuit.size() > size)
+            continue;
+
+        uint cost = 0;
+        if (getElementsFromLocalGates(circuit, n, lines, lineCount,
+                isNegativeControlInputsAllowed, &candidate, &cost) &&
+            isBetterReplacement(windowCost, size, cost, candidate.size(),
+                &bestCostGain, &bestSizeGain))
+        {
+            *windowSize = size;
+            *replacement = candidate;
+        }
+    }
+
+    return *windowSize != 0;
 }
 
-PostProcessor::OptScheme PostProcessor::removeDuplicates(const OptScheme& scheme)
+void PostProcessor::resynthesisOptimization(OptScheme* scheme, bool* optimized,
+    DirtyRegions* regions /*= 0*/)
 {
-    OptScheme optimizedScheme = scheme;
-    int startIndex = 0;
-    bool repeat = true;
+    assertd(optimized, string("Null 'optimized' pointer (PostProcessor::resynthesisOptimization)"));
+
+    if (!ProgramOptions::get().options.getBool("do-optimal-resynthesis", true))
+        return;
+
+    OptScheme& elements = *scheme;
+    vector<ReverseElement> replacement;
+    PassReport result;
 
-    while(repeat)
+    vector<Range> ranges;
+    if (regions)
+        ranges.swap(regions->passes[opResynthesis]);
+    else if (!elements.empty())
+        ranges.push_back(Range{ 0, (uint)elements.size() - 1 });
+
+    // elements after examined ones are only shifted by replacements
+    int shift = 0;
+    uint examinedEnd = 0;
+
+    for (auto& range : ranges)
     {
-        optimizedScheme = tryOptimizationTactics(optimizedScheme, selectEqual,
-            swapEqualElements, &repeat, false, true, &startIndex);
+        uint first = (uint)max((int)range.start + shift, (int)examinedEnd);
+        uint end = range.end + 1 + shift;
+        if (end <= examinedEnd)
+            continue;
+
+        // blocks with dirty elements could start before them
+        uint index = max(findLocalBlockStart(elements, first), examinedEnd);
+        while (index < end && !isTimeOver())
+        {
+            uint blockSize = 0;
+            if (!findResynthesisReplacement(elements, index, first, &blockSize, &replacement))
+            {
+                ++index;
+                continue;
+            }
+
+            uint elementCount = elements.size();
+            replaceElements(&elements, index, blockSize,
+                replacement.cbegin(), replacement.cend(), regions, &result);
+
+            end = getShiftedEnd(end, index, blockSize, replacement.size());
+            shift += (int)elements.size() - (int)elementCount;
+            first = min(first, index);
+
+            *optimized = true;
+        }
+
+        examinedEnd = end;
     }
 
-    return optimizedScheme;
+    if (regions)
+        regions->passes[opResynthesis].clear();
+
+    addPassResult(opResynthesis, result);
 }
 
-PostProcessor::OptScheme PostProcessor::mergeOptimization(OptScheme& scheme, bool* optimized)
+bool PostProcessor::findResynthesisReplacement(const OptScheme& scheme, uint startIndex,
+    uint dirtyIndex, uint* blockSize, vector<ReverseElement>* replacement)
 {
-    auto selectFunc = (
-        isNegativeControlInputsAllowed ?
-        selectForMergeOptimization :
-        selectForMergeOptimizationWithoutInversions
-    );
+    assertd(blockSize && replacement,
+        string("PostProcessor::findResynthesisReplacement(): null ptr"));
 
-    return generalOptimization(scheme, optimized, selectFunc,
-        swapElementsWithMerge, false, false);
-}
+    typedef TemplateLibrary::TruthTable TruthTable;
+    const uint numMaxPrefixGateCount = 2;
 
-PostProcessor::OptScheme PostProcessor::reduceConnectionsOptimization( OptScheme& scheme, bool* optimized)
-{
-    return generalOptimization(scheme, optimized, selectForReduceConnectionsOptimization,
-        swapElementsWithConnectionReduction, false, false);
-}
+    uint elementCount = scheme.size();
+    uint n = scheme[startIndex].getInputCount();
 
-PostProcessor::OptScheme PostProcessor::transferOptimization(OptScheme& scheme, bool* optimized)
-{
-    return generalOptimization(scheme, optimized, selectForTransferOptimization,
-        swapElementsWithTransferOptimization, false, true);
-}
+    // lines of block in order of appearance, local line index is index in this array
+    word lines[TemplateLibrary::numLineCount];
+    uint lineCount = 0;
 
-PostProcessor::OptScheme PostProcessor::peresGateOptimization(OptScheme& scheme)
-{
-    OptScheme optimizedScheme = scheme;
-    int startIndex = 0;
-    bool repeat = true;
+    // maximal block on up to 4 lines and its prefix on up to 3 lines
+    TruthTable table = TemplateLibrary::getIdentity();
+    uint size = 0;
+    uint cost = 0;
+
+    TruthTable shortTable = table;
+    uint shortSize = 0;
+    uint shortCost = 0;
 
-    while (repeat)
+    for (uint index = startIndex; index < elementCount; ++index)
     {
-        optimizedScheme = tryOptimizationTactics(optimizedScheme, selectForPeresGateOptimization,
-            swapPeresElements, &repeat, false, false, &startIndex, false);
+        const ReverseElement& element = scheme[index];
+
+        TemplateLibrary::Gate gate;
+        if (!getLocalGate(element, lines, &lineCount, &gate))
+            break;
+
+        table = TemplateLibrary::applyGate(table, gate);
+        cost += SchemeUtils::getElementQuantumCost(element);
+        ++size;
+
+        if (lineCount <= OptimalSynthesisTable::numLineCount)
+        {
+            shortTable = table;
+            shortSize = size;
+            shortCost = cost;
+        }
     }
 
-    return optimizedScheme;
+    *blockSize = 0;
+
+    // block without dirty elements was examined before
+    if (startIndex + size <= dirtyIndex)
+        return false;
+
+    vector<TemplateLibrary::Gate> circuit;
+    vector<ReverseElement> candidate;
+    uint candidateCost = 0;
+
+    uint bestCostGain = 0;
+    uint bestSizeGain = 0;
+
+    // block on 3 lines is replaced by optimal circuit
+    if (shortSize > 1)
+    {
+        OptimalSynthesisTable::get().findCircuit(shortTable, &circuit);
+        uint shortLineCount = min(lineCount, (uint)OptimalSynthesisTable::numLineCount);
+        if (getElementsFromLocalGates(circuit, n, lines, shortLineCount,
+                isNegativeControlInputsAllowed, &candidate, &candidateCost) &&
+            isBetterReplacement(shortCost, shortSize, candidateCost, candidate.size(),
+                &bestCostGain, &bestSizeGain))
+        {
+            *blockSize = shortSize;
+            *replacement = candidate;
+        }
+    }
+
+    // block on 4 lines is looked up in template library, meet in the middle search is
+    // done only for blocks, which are maximal from the left and longer than library circuits
+    const TemplateLibrary& library = TemplateLibrary::get();
+    if (size > shortSize && library.isLoaded())
+    {
+        uint maxPrefixGateCount = 0;
+        if (size > library.getMaxGateCount())
+        {
+            uint lastLineCount = lineCount;
+            TemplateLibrary::Gate gate;
+
+            if (startIndex == 0 ||
+                !getLocalGate(scheme[startIndex - 1], lines, &lastLineCount, &gate))
+            {
+                maxPrefixGateCount = min(numMaxPrefixGateCount, size - library.getMaxGateCount());
+            }
+        }
+
+        if (library.findCircuit(table, maxPrefixGateCount, &circuit) &&
+            getElementsFromLocalGates(circuit, n, lines, lineCount,
+                isNegativeControlInputsAllowed, &candidate, &candidateCost) &&
+            isBetterReplacement(cost, size, candidateCost, candidate.size(),
+                &bestCostGain, &bestSizeGain))
+        {
+            *blockSize = size;
+            *replacement = candidate;
+        }
+    }
+
+    return *blockSize != 0;
 }
 
-PostProcessor::OptScheme PostProcessor::generalOptimization(OptScheme& scheme,
+void PostProcessor::generalOptimization(OptScheme* scheme,
     bool* optimized, SelectionFunc selectFunc, SwapFunc swapFunc,
-    bool searchPairFromEnd, bool lessComplexityRequired, bool useNeighborElements /*= true*/)
+    bool searchPairFromEnd, bool lessComplexityRequired, bool useNeighborElements /*= true*/,
+    DirtyRegions* regions /*= 0*/, OptimizationPass pass /*= opMerge*/)
 {
     assertd(optimized, string("Null 'optimized' pointer (PostProcessor::generalOptimization)"));
     *optimized = false;
 
-    OptScheme optimizedScheme = scheme;
+    OptScheme& elements = *scheme;
     const uint numMaxSubSchemeSize = ProgramOptions::get().maxSubSchemeSizeForOptimization;
+    const uint maxDistance = ProgramOptions::get().maxElementsDistanceForOptimization;
+
+    DirtyRegions localRegions(regions ? 0 : (uint)elements.size());
+    if (!regions)
+        regions = &localRegions;
+
+    assertd(pass < opPeres, string("PostProcessor::generalOptimization(): wrong pass"));
+    vector<Range>& dirtyRanges = regions->passes[pass];
+
+    vector<Range> windows;
+    vector<uint> firstDirtyIndices;
+    vector<OptScheme> subSchemes;
+    vector<uint> changedFlags; //not vector<bool>, flags are written concurrently
+    vector<uint> firstChangedIndices;
+    vector<uint> changedEndIndices;
+    PassReport result;
 
     bool repeatOuter = true;
-    while (repeatOuter)
+    while (repeatOuter && !isTimeOver())
     {
         repeatOuter = false;
+        regions->changed.clear();
 
-        uint schemeSize = optimizedScheme.size();
-        uint stepCount = (schemeSize + numMaxSubSchemeSize - 1) / numMaxSubSchemeSize;
+        // the second round is done on windows shifted by half of window size,
+        // so pairs of elements near window borders are also optimized
+        for (uint round = 0; round < 2 && !isTimeOver(); ++round)
+        {
+            uint schemeSize = elements.size();
+            if (round && schemeSize <= numMaxSubSchemeSize)
+                break; //all pairs were examined in the first round
 
-        OptScheme::const_iterator first = optimizedScheme.cbegin();
-        uint currentProgress = 0;
+            uint offset = (round ? numMaxSubSchemeSize / 2 : 0);
 
-        OptScheme tempScheme;
-        for (uint step = 0; step < stepCount; ++step)
-        {
-            OptScheme::const_iterator last;
-            if (currentProgress + numMaxSubSchemeSize <= schemeSize)
-                last = first + numMaxSubSchemeSize;
-            else
-                last = first + (schemeSize - currentProgress);
+            // windows without dirty elements were examined before
+            windows.clear();
+            firstDirtyIndices.clear();
+            splitScheme(dirtyRanges, schemeSize, offset, numMaxSubSchemeSize,
+                &windows, &firstDirtyIndices);
+
+            uint windowCount = windows.size();
+            if (!windowCount)
+                continue;
 
-            OptScheme subScheme(first, last);
+            subSchemes.resize(windowCount);
+            changedFlags.assign(windowCount, 0);
+            firstChangedIndices.assign(windowCount, uintUndefined);
+            changedEndIndices.assign(windowCount, 0);
 
-            bool repeatInner = true;
-            while (repeatInner)
+            // windows are independent, so they are optimized concurrently
+            ThreadPool::get().parallelFor(windowCount, [&](uint index)
+            {
+                const Range& window = windows[index];
+                OptScheme& subScheme = subSchemes[index];
+                subScheme.assign(elements.cbegin() + window.start,
+                    elements.cbegin() + window.end + 1);
+
+                // pairs of elements far before the first dirty one were examined before;
+                // pairs after it are examined till the end of window, because rewrite with
+                // cleanup is accepted, if it reduces scheme anywhere after changed elements
+                uint firstDirty = firstDirtyIndices[index] - window.start;
+                uint startIndex = (firstDirty > maxDistance ? firstDirty - maxDistance : 0);
+
+                changedFlags[index] = rewriteScheme(&subScheme, selectFunc, swapFunc,
+                    searchPairFromEnd, lessComplexityRequired, useNeighborElements,
+                    startIndex, &firstChangedIndices[index], &changedEndIndices[index]);
+            });
+
+            // changed parts of windows are put back from the last window,
+            // so positions of previous windows are kept; they are dirty for all passes
+            for (uint index = windowCount; index-- > 0; )
             {
-                subScheme = tryOptimizationTactics(subScheme, selectFunc,
-                    swapFunc, &repeatInner, searchPairFromEnd,
-                    lessComplexityRequired, 0, useNeighborElements);
+                if (!changedFlags[index])
+                    continue;
 
-                *optimized = *optimized || repeatInner;
-                repeatOuter = repeatOuter || repeatInner;
-            }
+                const Range& window = windows[index];
+                const OptScheme& subScheme = subSchemes[index];
 
-            tempScheme.insert(tempScheme.end(), subScheme.cbegin(), subScheme.cend());
+                uint first = firstChangedIndices[index];
+                uint last = changedEndIndices[index];
+                uint count = last - first + (window.end + 1 - window.start) - subScheme.size();
 
-            currentProgress += numMaxSubSchemeSize;
-            first = last;
+                replaceElements(&elements, window.start + first, count,
+                    subScheme.cbegin() + first, subScheme.cbegin() + last, regions, &result);
+
+                *optimized = true;
+                repeatOuter = true;
+            }
         }
 
-        optimizedScheme = tempScheme;
+        // elements changed in this round are examined in the next one, others are clean
+        dirtyRanges.swap(regions->changed);
     }
 
-    return optimizedScheme;
+    regions->changed.clear();
+    addPassResult(pass, result);
+}
+
+//static
+void PostProcessor::splitScheme(const vector<Range>& dirtyRanges, uint schemeSize, uint offset,
+    uint subSchemeSize, vector<Range>* windows, vector<uint>* firstDirtyIndices)
+{
+    assertd(windows && firstDirtyIndices && subSchemeSize,
+        string("Wrong params (PostProcessor::splitScheme)"));
+
+    uint firstWindowSize = (offset ? offset : subSchemeSize);
+
+    auto getWindowIndex = [&](uint index) -> uint
+    {
+        return (index < firstWindowSize ? 0 : (index - firstWindowSize) / subSchemeSize + 1);
+    };
+
+    auto getWindowStart = [&](uint windowIndex) -> uint
+    {
+        return (windowIndex ? firstWindowSize + (windowIndex - 1) * subSchemeSize : 0);
+    };
+
+    uint lastWindowIndex = uintUndefined;
+    for (auto& range : dirtyRanges)
+    {
+        assertd(range.end < schemeSize, string("Wrong dirty range (PostProcessor::splitScheme)"));
+
+        uint windowIndex = getWindowIndex(range.start);
+        if (windowIndex == lastWindowIndex)
+            ++windowIndex;
+
+        for (; windowIndex <= getWindowIndex(range.end); ++windowIndex)
+        {
+            uint first = getWindowStart(windowIndex);
+            uint last = min(getWindowStart(windowIndex + 1), schemeSize) - 1;
+
+            windows->push_back(Range{ first, last });
+            firstDirtyIndices->push_back(max(range.start, first));
+        }
+
+        lastWindowIndex = windowIndex - 1;
+    }
 }
 
 PostProcessor::OptScheme PostProcessor::getFullScheme(const OptScheme& scheme,
@@ -672,167 +1702,334 @@ PostProcessor::OptScheme PostProcessor::getFinalSchemeImplementation(const OptSc
 // Main optimization tactic implementation
 //////////////////////////////////////////////////////////////////////////
 
-PostProcessor::OptScheme PostProcessor::tryOptimizationTactics(const OptScheme& scheme,
-    SelectionFunc selectionFunc, SwapFunc swapFunc,
-    bool* optimizationSucceeded, bool searchPairFromEnd,
-    bool lessComplexityRequired, int* startIndex /* = 0 */, bool useNeighborElements /*= true*/)
+PostProcessor::PairKind PostProcessor::getPairKind(SelectionFunc selectionFunc)
 {
-    assertd(optimizationSucceeded,
-        string("Null ptr 'optimizationSucceeded' (PostProcessor::tryOptimizationTactics)"));
-    *optimizationSucceeded = false;
+    PairKind kind = pkAny;
 
-    OptScheme optimizedScheme = scheme;
+    if (selectionFunc == selectEqual ||
+        selectionFunc == selectForMergeOptimization ||
+        selectionFunc == selectForMergeOptimizationWithoutInversions ||
+        selectionFunc == selectForReduceConnectionsOptimization)
+    {
+        kind = pkSameTarget;
+    }
+    else if (selectionFunc == selectForTransferOptimization)
+        kind = pkNonCommuting;
+
+    return kind;
+}
+
+bool PostProcessor::rewriteScheme(OptScheme* scheme, SelectionFunc selectionFunc, SwapFunc swapFunc,
+    bool searchPairFromEnd, bool lessComplexityRequired, bool useNeighborElements /*= true*/,
+    uint startIndex /*= 0*/, uint* firstChangedIndex /*= 0*/, uint* changedEndIndex /*= 0*/,
+    CommutationDag* dag /*= 0*/)
+{
+    assertd(scheme, string("Null ptr (PostProcessor::rewriteScheme)"));
+
+    const int maxDistance = (int)ProgramOptions::get().maxElementsDistanceForOptimization;
+    const bool useSwapResults =
+        ProgramOptions::get().options.getBool("use-swap-results-optimization-technique");
+
+    OptScheme& elements = *scheme;
+    uint firstChanged = uintUndefined;
+    uint changedEnd = 0;
+
+    // DAG is shared with nested calls, they change the same scheme
+    CommutationDag localDag;
+    if (!dag)
+    {
+        localDag.build(elements, maxDistance);
+        dag = &localDag;
+    }
 
-    bool schemeOptimized = false;
-    int elementCount = (int)scheme.size();
+    // elements are changed before selection in swap results technique
+    PairKind pairKind = (useSwapResults ? pkAny : getPairKind(selectionFunc));
+    vector<uint> candidates;
 
-    // find left element index
-    for (int leftIndex = startIndex ? *startIndex : 0;
-        !schemeOptimized && leftIndex < elementCount - 1; ++leftIndex)
+    // swap results are reused by pairs with common elements until scheme is rewritten
+    SwapResultsCache swapResultsCache;
+    vector<PairPositions> pairPositions;
+
+    if (useSwapResults)
+        resetSwapResultsCache(&swapResultsCache, elements.size());
+
+    // elements between pair of optimized elements before rewrite, the whole scheme and
+    // DAG before rewrite, they are needed only when rewrite could be rolled back
+    OptScheme rangeBackup;
+    OptScheme schemeBackup;
+    CommutationDag dagBackup;
+
+    list<ReverseElement> leftReplacement;
+    list<ReverseElement> rightReplacement;
+
+    // Worklist of positions of left element in pair: all pairs with left element before
+    // @leftIndex were already examined and weren't changed since then, so dirty positions
+    // always form a suffix of the scheme and worklist is represented by its first position
+    int leftIndex = (int)startIndex;
+    while (leftIndex < (int)elements.size() - 1 && !isTimeOver())
     {
-        if (startIndex)
-            *startIndex = leftIndex;
+        int elementCount = (int)elements.size();
+        int nextLeftIndex = leftIndex + 1;
 
-        if (!useNeighborElements)
+        // element, which already has neighbor pair, is left as is
+        auto hasNeighborPair = [&elements, elementCount, selectionFunc](int index) -> bool
         {
-            const ReverseElement& element = scheme[leftIndex];
-            if (leftIndex > 0 && selectionFunc(element, scheme[leftIndex - 1]))
-                continue;
+            const ReverseElement& element = elements[index];
+            return (index > 0 && selectionFunc(element, elements[index - 1])) ||
+                (index < elementCount - 1 && selectionFunc(element, elements[index + 1]));
+        };
 
-            if (selectionFunc(element, scheme[leftIndex + 1]))
-                continue;
+        if (!useNeighborElements && hasNeighborPair(leftIndex))
+        {
+            leftIndex = nextLeftIndex;
+            continue;
         }
 
+        getPairCandidates(*dag, pairKind, leftIndex, elementCount, searchPairFromEnd, &candidates);
         uint leftElementMaxTransferIndex = uintUndefined;
 
-        // find right element index
-        for (int rightIndex = (searchPairFromEnd ? elementCount - 1 : leftIndex + 1);
-            !schemeOptimized && (searchPairFromEnd ? rightIndex > leftIndex : rightIndex < elementCount);
-            rightIndex += (searchPairFromEnd ? -1 : 1))
+        if (useSwapResults)
+        {
+            findSwapResultsPairPositions(elements, selectionFunc, leftIndex, candidates,
+                &swapResultsCache, &pairPositions);
+        }
+
+        uint candidateCount = candidates.size();
+        for (uint candidateIndex = 0; candidateIndex < candidateCount; ++candidateIndex)
         {
-            if ((uint)abs(leftIndex - rightIndex) > ProgramOptions::get().maxElementsDistanceForOptimization)
-                break;
+            uint rightIndex = candidates[candidateIndex];
 
-            if (!useNeighborElements && abs(leftIndex - rightIndex) == 1)
+            // otherwise elements could be moved from one pair to another infinitely
+            if (!useNeighborElements && (rightIndex == leftIndex + 1 || hasNeighborPair(rightIndex)))
                 continue;
 
             uint newLeftIndex  = uintUndefined;
             uint newRightIndex = uintUndefined;
 
-            bool isElementsPairGoodForOptimization = false;
-            if (ProgramOptions::get().options.getBool("use-swap-results-optimization-technique"))
+            if (useSwapResults)
+            {
+                // scheme is the same here, rewrites of previous candidates were rolled back
+                const PairPositions& positions = pairPositions[candidateIndex];
+                if (!positions.found)
+                    continue;
+
+                newLeftIndex  = positions.newLeftIndex;
+                newRightIndex = positions.newRightIndex;
+            }
+            else if (!findPairPositions(elements, *dag, selectionFunc, leftIndex, rightIndex,
+                &leftElementMaxTransferIndex, &newLeftIndex, &newRightIndex))
+            {
+                continue;
+            }
+
+            // only elements in [rangeFirst, rangeLast] are changed by moving
+            uint rangeFirst = min((uint)leftIndex, newLeftIndex);
+            uint rangeLast  = max(rightIndex, newRightIndex);
+            uint rangeSize  = rangeLast - rangeFirst + 1;
+
+            if (lessComplexityRequired)
             {
-                SwapResultsPair pair = getSwapResultsPair(scheme, leftIndex, rightIndex);
+                rangeBackup.assign(elements.cbegin() + rangeFirst, elements.cbegin() + rangeLast + 1);
+                dagBackup = *dag;
+            }
 
-                isElementsPairGoodForOptimization =
-                    isSwapResultsPairSuiteOptimizationTactics(selectionFunc, pair,
-                    leftIndex, rightIndex, &newLeftIndex, &newRightIndex);
+            // move elements to new positions
+            if (newLeftIndex < rightIndex)
+            {
+                moveElementInScheme(&elements, leftIndex, newLeftIndex);
+                moveElementInScheme(&elements, rightIndex, newRightIndex);
             }
             else
             {
-                const ReverseElement& left = scheme[leftIndex];
-                const ReverseElement& right = scheme[rightIndex];
+                moveElementInScheme(&elements, rightIndex, newRightIndex);
+                moveElementInScheme(&elements, leftIndex, newLeftIndex);
+            }
 
-                // 1) check right element with selection function
-                if (!selectionFunc(left, right))
-                    continue;
+            // apply swap function
+            leftReplacement.clear();
+            rightReplacement.clear();
 
-                newLeftIndex = (uint)leftIndex;
-                newRightIndex = (uint)rightIndex;
+            swapFunc(elements[newLeftIndex], elements[newRightIndex],
+                &leftReplacement, &rightReplacement);
 
-                // transfer elements if needed
-                if (newLeftIndex + 1 != newRightIndex)
-                {
-                    // transfer right element to left at maximum
-                    newRightIndex = getMaximumTransferIndex(scheme, right, rightIndex, leftIndex);
-                    if (newRightIndex != leftIndex + 1)
-                    {
-                        // transfer left element to left at maximum (just once)
-                        if (leftElementMaxTransferIndex == uintUndefined)
-                        {
-                            leftElementMaxTransferIndex = getMaximumTransferIndex(scheme, left,
-                                leftIndex, elementCount - 1);
-                        }
+            replacePairInScheme(&elements, newLeftIndex, leftReplacement, rightReplacement);
 
-                        newLeftIndex = leftElementMaxTransferIndex;
-                    }
+            uint sizeBefore = (uint)elementCount;
+            uint replacedCount = rangeSize + elements.size() - sizeBefore;
 
-                    // compare indices
-                    if (newLeftIndex + 1 >= newRightIndex)
-                        // good right element, try to apply optimization
-                        newLeftIndex = newRightIndex - 1; // keep left element maximum left aligned
-                    else
-                        continue;
+            dag->update(elements, rangeFirst, rangeSize, replacedCount);
+
+            // elements changed by this rewrite including cleanup below
+            uint changedIndex = rangeFirst;
+            uint changedIndexEnd = rangeFirst + replacedCount;
+
+            auto cleanup = [&](SelectionFunc cleanupSelectionFunc, SwapFunc cleanupSwapFunc,
+                bool cleanupLessComplexityRequired)
+            {
+                uint cleanupSizeBefore = elements.size();
+                uint cleanupFirst = uintUndefined;
+                uint cleanupChangedEnd = 0;
+
+                if (rewriteScheme(&elements, cleanupSelectionFunc, cleanupSwapFunc,
+                    false, cleanupLessComplexityRequired, true,
+                    (uint)max((int)changedIndex - maxDistance, 0),
+                    &cleanupFirst, &cleanupChangedEnd, dag))
+                {
+                    uint count = cleanupChangedEnd - cleanupFirst;
+                    updateChangedRange(cleanupFirst, count + cleanupSizeBefore - elements.size(),
+                        count, &changedIndex, &changedIndexEnd);
                 }
+            };
 
-                isElementsPairGoodForOptimization = true;
-            }
-        
-            if (isElementsPairGoodForOptimization)
+            if (elements.size() >= sizeBefore)
             {
-                // move elements to new positions
-                if (newLeftIndex < (uint)rightIndex)
+                if (lessComplexityRequired)
                 {
-                    moveElementInScheme(&optimizedScheme, leftIndex, newLeftIndex);
-                    moveElementInScheme(&optimizedScheme, rightIndex, newRightIndex);
+                    // restore scheme before rewrite from the range backup
+                    schemeBackup.assign(elements.cbegin(), elements.cbegin() + rangeFirst);
+                    schemeBackup.insert(schemeBackup.end(), rangeBackup.cbegin(), rangeBackup.cend());
+                    schemeBackup.insert(schemeBackup.end(),
+                        elements.cbegin() + rangeFirst + replacedCount, elements.cend());
                 }
-                else
+
+                // now try to optimize this scheme near changed elements,
+                // duplicates are always removed, so that rewrites are never rolled back
+                cleanup(selectEqual, swapEqualElements, false);
+
+                if (isNegativeControlInputsAllowed)
+                    cleanup(selectForMergeOptimization, swapElementsWithMerge, false);
+
+                if (lessComplexityRequired && elements.size() >= sizeBefore)
                 {
-                    moveElementInScheme(&optimizedScheme, rightIndex, newRightIndex);
-                    moveElementInScheme(&optimizedScheme, leftIndex, newLeftIndex);
+                    // rewrite is rolled back, continue search for right element
+                    elements.swap(schemeBackup);
+                    swap(*dag, dagBackup);
+                    continue;
                 }
+            }
+
+            uint changedCount = changedIndexEnd - changedIndex;
+            uint oldChangedCount = changedCount + sizeBefore - elements.size();
 
-                // apply swap function
-                const ReverseElement& leftElement = optimizedScheme[newLeftIndex];
-                list<ReverseElement> leftReplacement;
+            updateChangedRange(changedIndex, oldChangedCount, changedCount,
+                &firstChanged, &changedEnd);
 
-                const ReverseElement& rightElement = optimizedScheme[newRightIndex];
-                list<ReverseElement> rightReplacement;
+            // pairs before changed elements are not affected by rewrite, if their distance
+            // is greater than maximum one; when scheme wasn't reduced, the search is continued
+            // from the current position, otherwise rewrites could be applied infinitely
+            if (elements.size() < sizeBefore)
+                nextLeftIndex = max((int)changedIndex - maxDistance, 0);
+            else
+                nextLeftIndex = min(leftIndex, (int)changedIndex);
 
-                swapFunc(leftElement, rightElement, &leftReplacement, &rightReplacement);
+            if (useSwapResults)
+                resetSwapResultsCache(&swapResultsCache, elements.size());
 
-                // replace elements with swap result
-                Optimizations optimizations;
-                prepareSchemeForOptimization(optimizedScheme, &optimizations);
+            break;
+        }
 
-                optimizations[newLeftIndex].replace = true;
-                optimizations[newLeftIndex].replacement = leftReplacement;
+        leftIndex = nextLeftIndex;
+    }
 
-                optimizations[newRightIndex].replace = true;
-                optimizations[newRightIndex].replacement = rightReplacement;
+    if (firstChangedIndex)
+        *firstChangedIndex = firstChanged;
 
-                optimizedScheme = applyOptimizations(optimizedScheme, optimizations);
-                if (optimizedScheme.size() >= scheme.size())
-                {
-                    // now try to optimize this scheme
-                    optimizedScheme = removeDuplicates(optimizedScheme);
+    if (changedEndIndex)
+        *changedEndIndex = changedEnd;
 
-                    if (isNegativeControlInputsAllowed)
-                    {
-                        bool optimized;
-                        optimizedScheme = mergeOptimization(optimizedScheme, &optimized);
-                    }
+    return firstChanged != uintUndefined;
+}
 
-                    if (lessComplexityRequired)
-                        schemeOptimized = optimizedScheme.size() < scheme.size();
-                    else
-                        schemeOptimized = true;
-                }
-                else
-                    schemeOptimized = true;
+void PostProcessor::getPairCandidates(const CommutationDag& dag, PairKind pairKind,
+    uint leftIndex, uint elementCount, bool searchPairFromEnd, vector<uint>* candidates)
+{
+    uint maxDistance = dag.getMaxDistance();
+
+    candidates->clear();
+    if (searchPairFromEnd && elementCount - 1 - leftIndex > maxDistance)
+        return; //search from the end is done only near the end of scheme
+
+    switch (pairKind)
+    {
+    case pkSameTarget:
+        dag.getSameTargetSuccessors(leftIndex, candidates);
+        break;
+
+    case pkNonCommuting:
+        dag.getNonCommutingSuccessors(leftIndex, candidates);
+        break;
+
+    default:
+        {
+            uint lastIndex = min(leftIndex + maxDistance, elementCount - 1);
+            for (uint index = leftIndex + 1; index <= lastIndex; ++index)
+                candidates->push_back(index);
+        }
+    }
+
+    if (searchPairFromEnd)
+        reverse(candidates->begin(), candidates->end());
+}
 
-                if (!schemeOptimized)
-                    optimizedScheme = scheme;
+bool PostProcessor::findPairPositions(const OptScheme& scheme, const CommutationDag& dag,
+    SelectionFunc selectionFunc, uint leftIndex, uint rightIndex,
+    uint* leftElementMaxTransferIndex, uint* newLeftIndex, uint* newRightIndex)
+{
+    // 1) check right element with selection function
+    if (!selectionFunc(scheme[leftIndex], scheme[rightIndex]))
+        return false;
+
+    *newLeftIndex  = leftIndex;
+    *newRightIndex = rightIndex;
+
+    // transfer elements if needed
+    if (*newLeftIndex + 1 != *newRightIndex)
+    {
+        // transfer right element to left at maximum
+        *newRightIndex = dag.getMaximumTransferIndex(rightIndex, leftIndex);
+        if (*newRightIndex != leftIndex + 1)
+        {
+            // transfer left element to left at maximum (just once)
+            if (*leftElementMaxTransferIndex == uintUndefined)
+            {
+                *leftElementMaxTransferIndex = dag.getMaximumTransferIndex(leftIndex,
+                    scheme.size() - 1);
             }
+
+            *newLeftIndex = *leftElementMaxTransferIndex;
         }
+
+        // compare indices
+        if (*newLeftIndex + 1 >= *newRightIndex)
+            // good right element, try to apply optimization
+            *newLeftIndex = *newRightIndex - 1; // keep left element maximum left aligned
+        else
+            return false;
     }
 
-    *optimizationSucceeded = schemeOptimized;
-    return optimizedScheme;
+    return true;
+}
+
+void PostProcessor::replacePairInScheme(OptScheme* scheme, uint index,
+    const list<ReverseElement>& leftReplacement, const list<ReverseElement>& rightReplacement)
+{
+    assertd(scheme && index + 1 < scheme->size(),
+        string("Wrong index (PostProcessor::replacePairInScheme)"));
+
+    uint replacementSize = leftReplacement.size() + rightReplacement.size();
+
+    OptScheme::iterator position = scheme->begin() + index;
+    if (replacementSize < 2)
+        position = scheme->erase(position, position + (2 - replacementSize));
+    else if (replacementSize > 2)
+        position = scheme->insert(position, replacementSize - 2, ReverseElement());
+
+    position = copy(leftReplacement.cbegin(), leftReplacement.cend(), position);
+    copy(rightReplacement.cbegin(), rightReplacement.cend(), position);
 }
 
-deque<PostProcessor::SwapResult> PostProcessor::getSwapResult(OptScheme* scheme,
-    uint startIndex, bool toLeft)
+deque<PostProcessor::SwapResult> PostProcessor::getSwapResult(const OptScheme& scheme,
+    uint startIndex, bool toLeft, SchemePatch* moved /*= 0*/, const SchemePatch* patch /*= 0*/)
 {
     deque<SwapResult> result;
 
@@ -842,51 +2039,42 @@ deque<PostProcessor::SwapResult> PostProcessor::getSwapResult(OptScheme* scheme,
 
     if (!toLeft)
     {
-        stopIndex = scheme->size() - 1;
+        stopIndex = scheme.size() - 1;
         step = 1;
     }
 
     if (index == stopIndex)
         return result;
 
-    Range range = { index, index };
-    ReverseElement target = (*scheme)[index];
-
-    do
+    auto getElement = [&scheme, patch](uint index) -> const ReverseElement&
     {
-        index += step;
-        ReverseElement& another = (*scheme)[index];
+        if (patch && index >= patch->start && index - patch->start < patch->elements.size())
+            return patch->elements[index - patch->start];
 
-        bool withOneControlLineInverting = false;
-        if (target.isSwappable(another, &withOneControlLineInverting, !isNegativeControlInputsAllowed))
-        {
-            // swap elements
-            ReverseElement& targetCopy = (*scheme)[index - step];
-            targetCopy.swap(&another);
+        return scheme[index];
+    };
 
-            if (!withOneControlLineInverting)
-                range.end += step;
-            else
-            {
-                // remember current swap result
-                range.sort();
-                SwapResult sr = { target, range };
+    Range range = { index, index };
+    const ReverseElement& target = getElement(index);
 
-                if (toLeft)
-                    result.push_front(sr);
-                else
-                    result.push_back(sr);
+    // elements passed by target after swaps, in order of moving
+    OptScheme passedElements;
 
-                // create new range
-                range = { index, index };
-            }
+    do
+    {
+        index += step;
+        const ReverseElement& another = getElement(index);
 
-            // save result for next iteration
-            target = another;
-        }
-        else
+        // swaps with control line inversion accepted by isSwappable() are not always
+        // supported by ReverseElement::swap(), so target passes only independent elements
+        if (!target.isSwappable(another))
             break;
 
+        // independent elements are not changed by swap, so @scheme is left as is
+        if (moved)
+            passedElements.push_back(another);
+
+        range.end += step;
     } while (index != stopIndex);
 
     // remember current swap result
@@ -898,11 +2086,76 @@ deque<PostProcessor::SwapResult> PostProcessor::getSwapResult(OptScheme* scheme,
     else
         result.push_back(sr);
 
+    if (moved)
+    {
+        // target stops at the farthest position, passed elements are shifted by one
+        OptScheme& elements = moved->elements;
+        elements.clear();
+
+        if (toLeft)
+        {
+            moved->start = startIndex - passedElements.size();
+            elements.push_back(target);
+            elements.insert(elements.end(), passedElements.crbegin(), passedElements.crend());
+        }
+        else
+        {
+            moved->start = startIndex;
+            elements = passedElements;
+            elements.push_back(target);
+        }
+    }
+
+    return result;
+}
+
+//static
+uint PostProcessor::getFarthestPosition(const deque<SwapResult>& result, uint startIndex,
+    bool toLeft)
+{
+    if (result.empty())
+        return startIndex;
+
+    return (toLeft ? result.front().second.start : result.back().second.end);
+}
+
+//static
+void PostProcessor::resetSwapResultsCache(SwapResultsCache* cache, uint elementCount)
+{
+    if (elementCount > cache->results.size())
+        cache->results.resize(elementCount);
+
+    if (++cache->generation == 0)
+    {
+        // stamps of old generations could coincide with new ones after overflow
+        cache->stamps.assign(cache->stamps.size(), 0);
+        cache->generation = 1;
+    }
+
+    cache->stamps.resize(max(elementCount, (uint)cache->stamps.size()), 0);
+}
+
+const deque<PostProcessor::SwapResult>& PostProcessor::getCachedSwapResults(
+    const OptScheme& scheme, SwapResultsCache* cache, uint index)
+{
+    assertd(index < cache->stamps.size(),
+        string("Wrong index (PostProcessor::getCachedSwapResults)"));
+
+    deque<SwapResult>& result = cache->results[index];
+    if (cache->stamps[index] != cache->generation)
+    {
+        deque<SwapResult> toLeft  = getSwapResult(scheme, index, true);
+        deque<SwapResult> toRight = getSwapResult(scheme, index, false);
+
+        result = mergeSwapResults(toLeft, toRight);
+        cache->stamps[index] = cache->generation;
+    }
+
     return result;
 }
 
-PostProcessor::SwapResultsPair PostProcessor::getSwapResultsPair(
-    const OptScheme& scheme, uint leftIndex, uint rightIndex)
+void PostProcessor::getSwapResultsPair(const OptScheme& scheme, uint leftIndex, uint rightIndex,
+    SwapResultsCache* cache, SwapResultsPair* pair)
 {
     uint schemeSize = scheme.size();
     assertd(leftIndex < schemeSize && rightIndex < schemeSize,
@@ -911,22 +2164,65 @@ PostProcessor::SwapResultsPair PostProcessor::getSwapResultsPair(
     // TODO: check if this would be necessary
     assertd(leftIndex < rightIndex, string("Unordered indices (PostProcessor::getSwapResultsPair)"));
 
-    // move to left
-    OptScheme schemeCopy = scheme;
-    deque<SwapResult> forLeftToLeft  = getSwapResult(&schemeCopy, leftIndex,  true);
-    deque<SwapResult> forRightToLeft = getSwapResult(&schemeCopy, rightIndex, true);
+    const deque<SwapResult>& forLeft  = getCachedSwapResults(scheme, cache, leftIndex);
+    const deque<SwapResult>& forRight = getCachedSwapResults(scheme, cache, rightIndex);
 
-    // move to right
-    schemeCopy = scheme;
-    deque<SwapResult> forRightToRight = getSwapResult(&schemeCopy, rightIndex, false);
-    deque<SwapResult> forLeftToRight  = getSwapResult(&schemeCopy, leftIndex,  false);
+    pair->forLeft  = &forLeft;
+    pair->forRight = &forRight;
 
-    // merge results
-    SwapResultsPair result;
-    result.forLeft = mergeSwapResults(forLeftToLeft, forLeftToRight);
-    result.forRight = mergeSwapResults(forRightToLeft, forRightToRight);
+    // elements are moved to left: left element first, then right one; right element meets
+    // elements changed by moving of left one only if it reaches them, otherwise its results
+    // are the same as in unchanged scheme
+    if (getFarthestPosition(forLeft, leftIndex, true) != leftIndex &&
+        getFarthestPosition(forRight, rightIndex, true) < leftIndex + 2)
+    {
+        SchemePatch moved;
+        getSwapResult(scheme, leftIndex, true, &moved);
 
-    return result;
+        deque<SwapResult> toLeft  = getSwapResult(scheme, rightIndex, true, 0, &moved);
+        deque<SwapResult> toRight = getSwapResult(scheme, rightIndex, false);
+
+        pair->rightStorage.reset(new deque<SwapResult>(mergeSwapResults(toLeft, toRight)));
+        pair->forRight = pair->rightStorage.get();
+    }
+
+    // same for moving to right: right element first, then left one
+    if (getFarthestPosition(forRight, rightIndex, false) != rightIndex &&
+        getFarthestPosition(forLeft, leftIndex, false) + 2 > rightIndex)
+    {
+        SchemePatch moved;
+        getSwapResult(scheme, rightIndex, false, &moved);
+
+        deque<SwapResult> toLeft  = getSwapResult(scheme, leftIndex, true);
+        deque<SwapResult> toRight = getSwapResult(scheme, leftIndex, false, 0, &moved);
+
+        pair->leftStorage.reset(new deque<SwapResult>(mergeSwapResults(toLeft, toRight)));
+        pair->forLeft = pair->leftStorage.get();
+    }
+}
+
+void PostProcessor::findSwapResultsPairPositions(const OptScheme& scheme,
+    SelectionFunc selectionFunc, uint leftIndex, const vector<uint>& candidates,
+    SwapResultsCache* cache, vector<PairPositions>* positions)
+{
+    // swap results of left element are shared by all pairs, they are computed before
+    // fan out, so concurrent tasks write only cache entries of their right elements
+    getCachedSwapResults(scheme, cache, leftIndex);
+
+    uint candidateCount = candidates.size();
+    positions->resize(candidateCount);
+
+    ThreadPool::get().parallelFor(candidateCount, [&](uint index)
+    {
+        uint rightIndex = candidates[index];
+        PairPositions& position = (*positions)[index];
+
+        SwapResultsPair pair;
+        getSwapResultsPair(scheme, leftIndex, rightIndex, cache, &pair);
+
+        position.found = isSwapResultsPairSuiteOptimizationTactics(selectionFunc, pair,
+            leftIndex, rightIndex, &position.newLeftIndex, &position.newRightIndex);
+    });
 }
 
 deque<PostProcessor::SwapResult> PostProcessor::mergeSwapResults(
@@ -972,15 +2268,15 @@ bool PostProcessor::isSwapResultsPairSuiteOptimizationTactics(
     assertd(newLeftIndex && newRightIndex, string("Null ptr "
         "(PostProcessor::isSwapResultsPairSuiteOptimizationTactics)"));
 
-    assertd(result.forLeft.size() && result.forRight.size(),
+    assertd(result.forLeft->size() && result.forRight->size(),
         string("Wrong swap result (PostProcessor::isSwapResultsPairSuiteOptimizationTactics)"));
 
     uint minDistance = uintUndefined;
     bool answer = false;
 
-    for (auto& left : result.forLeft)
+    for (auto& left : *result.forLeft)
     {
-        for (auto& right : result.forRight)
+        for (auto& right : *result.forRight)
         {
             if (selectionFunc(left.first, right.first))
             {
@@ -1040,35 +2336,4 @@ void PostProcessor::moveElementInScheme(OptScheme* scheme,
     }
 }
 
-uint PostProcessor::getMaximumTransferIndex(const OptScheme& scheme,
-    const ReverseElement& target, uint startIndex, uint stopIndex) const
-{
-    uint elementCount = (uint)scheme.size();
-
-    assertd(startIndex < elementCount,
-        string("PostProcessor: invalid start index for getMaximumTransferIndex()"));
-
-    assertd(stopIndex < elementCount,
-        string("PostProcessor: invalid stop index for getMaximumTransferIndex()"));
-
-    int step = 1;
-    if (startIndex > stopIndex)
-        // from right to left
-        step = -1;
-
-    uint index = startIndex;
-    while (index != stopIndex)
-    {
-        const ReverseElement& neighborElement = scheme[index];
-        if (!target.isSwappable(neighborElement))
-            // stop search if not swappable
-            break;
-
-        index += step;
-    }
-
-    index -= step; // target element can be in previous position, not in the last
-    return index;
-}
-
 }   // namespace ReversibleLogic
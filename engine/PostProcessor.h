@@ -34,6 +34,45 @@ public:
 
     Scheme optimize(const Scheme& scheme);
 
+    /// Optimization passes, which revisit only elements changed since their last run
+    /// (except Peres gates optimization, which is done once at the end)
+    enum OptimizationPass
+    {
+        opDuplicates,
+        opMerge,
+        opTransfer,
+        opTemplate,
+        opResynthesis,
+        opPeres,
+        opPassCount,
+    };
+
+    static const char* getPassName(OptimizationPass pass);
+
+    /// Statistics of the last optimize() call; if post-processing-time-limit is exceeded,
+    /// optimization is stopped and the best scheme found so far is returned
+    struct PassReport
+    {
+        uint runCount = 0;
+        /// Could be negative, if pass implements elements with cheaper ones
+        int complexityReduction = 0;
+        /// Peres gates are taken into account only by Peres gates optimization,
+        /// other passes sum up quantum costs of replaced elements
+        int quantumCostReduction = 0;
+    };
+
+    struct Report
+    {
+        bool isInterrupted = false;
+        /// Names of stages of optimize() started before the time limit was exceeded
+        vector<string> stages;
+        uint stageCount = 0;
+        PassReport passes[opPassCount];
+    };
+
+    const Report& getReport() const;
+    void logReport(ostream& out) const;
+
 private:
     enum
     {
@@ -54,6 +93,59 @@ private:
     typedef void(*SwapFunc)(const ReverseElement& left, const ReverseElement& right,
         list<ReverseElement>* leftReplacement, list<ReverseElement>* rightReplacement);
 
+    /// Dirty regions of scheme: for each pass (except Peres gates optimization) sorted disjoint
+    /// ranges of elements, which were changed after the last run of the pass, so elements
+    /// near them should be examined again
+    struct DirtyRegions
+    {
+        /// All @elementCount elements are dirty for all passes
+        explicit DirtyRegions(uint elementCount);
+
+        vector<Range> passes[opPeres];
+        /// Elements changed in the current round of generalOptimization()
+        vector<Range> changed;
+    };
+
+    /// Updates @regions after @oldCount elements starting from @position were replaced by
+    /// @newCount elements, scheme has @elementCount elements after replacement. Replacement
+    /// (or its neighbors, if it is empty) becomes dirty for all passes
+    static void updateDirtyRegions(DirtyRegions* regions, uint position, uint oldCount,
+        uint newCount, uint elementCount);
+
+    /// Replaces @count elements of @scheme starting from @position by elements from
+    /// [@first, @last) in place, @regions are updated if they are not null,
+    /// reductions of complexity and quantum cost are added to @result
+    static void replaceElements(OptScheme* scheme, uint position, uint count,
+        OptScheme::const_iterator first, OptScheme::const_iterator last,
+        DirtyRegions* regions, PassReport* result);
+
+    enum FullSchemeType
+    {
+        fstSimple,
+        fstRecursive,
+        fstToffoli,
+    };
+
+    /// Starts optimization stage with @name, returns false if time limit is exceeded
+    bool startStage(const char* name);
+
+    /// Returns true if post-processing-time-limit is exceeded, could be called concurrently
+    bool isTimeOver() const;
+
+    /// Adds @result of one run of @pass to report, could be called concurrently
+    void addPassResult(OptimizationPass pass, const PassReport& result);
+
+    /// Removes duplicates, merge, transfer, template and resynthesis optimizations are applied
+    /// to @scheme in place until none of them changes it; only elements near dirty @regions
+    /// are examined, after the first round - only elements near the ones changed by other passes
+    void optimizeDirtyElements(OptScheme* scheme, DirtyRegions* regions);
+
+    /// Optimizes @scheme with elements decomposed by @type. Elements are decomposed only when
+    /// they are optimized: windows of @scheme without elements near their borders are decomposed
+    /// and optimized separately, then elements near borders are decomposed and optimized
+    /// together with optimized elements around them
+    OptScheme optimizeFullScheme(const OptScheme& scheme, FullSchemeType type);
+
     void prepareSchemeForOptimization(const OptScheme& scheme, Optimizations* optimizations);
     OptScheme applyOptimizations(const OptScheme& scheme, const Optimizations& optimizations);
 
@@ -62,73 +154,186 @@ private:
     OptScheme optimizeInversions(const OptScheme& scheme);
 
     /// Remove duplicates elements
-    OptScheme removeDuplicates(const OptScheme& scheme);
+    /// Scheme is changed in place. If @regions are specified, only elements near dirty ones
+    /// are examined and regions are updated, same for all optimizations below
+    void removeDuplicates(OptScheme* scheme, DirtyRegions* regions = 0);
 
     /// (01)(11) -> *1
-    OptScheme mergeOptimization(OptScheme& scheme, bool* optimized);
+    void mergeOptimization(OptScheme* scheme, bool* optimized, DirtyRegions* regions = 0);
     /// (01)(10) -> (*1)(1*)
-    OptScheme reduceConnectionsOptimization(OptScheme& scheme, bool* optimized);
+    void reduceConnectionsOptimization(OptScheme* scheme, bool* optimized);
 
     /// Transfer optimization: two elements are swapped with producing new element
-    OptScheme transferOptimization(OptScheme& scheme, bool* optimized);
+    void transferOptimization(OptScheme* scheme, bool* optimized, DirtyRegions* regions = 0);
 
     /// Peres gates optimization: make Peres gates instead of 2-CNOT and CNOT
-    OptScheme peresGateOptimization(OptScheme& scheme);
+    void peresGateOptimization(OptScheme* scheme);
+
+    /// Depth optimization: commuting elements are reordered (Peres gates are moved as a whole),
+    /// so that each element is placed to the earliest layer, where its lines are free.
+    /// Elements are kept as is, the scheme is returned unchanged if its depth is not decreased
+    OptScheme depthOptimization(const OptScheme& scheme);
+
+    /// Template optimization: windows of neighbor elements on up to 4 lines are replaced
+    /// by cheaper circuits from template library (see TemplateLibrary)
+    void templateOptimization(OptScheme* scheme, bool* optimized, DirtyRegions* regions = 0);
+
+    /// Searches for the most profitable window starting from @startIndex, which could be
+    /// replaced by circuit from @library. Returns false if there is no such window
+    bool findTemplateReplacement(const TemplateLibrary& library, const OptScheme& scheme,
+        uint startIndex, uint* windowSize, vector<ReverseElement>* replacement);
+
+    /// Optimal resynthesis: maximal blocks of neighbor elements on up to 3 lines are replaced
+    /// by optimal circuits (see OptimalSynthesisTable), blocks on 4 lines - by circuits from
+    /// template library found with meet in the middle search
+    void resynthesisOptimization(OptScheme* scheme, bool* optimized, DirtyRegions* regions = 0);
 
-    /// General optimization function for merge, reduce and transfer optimization
-    OptScheme generalOptimization(OptScheme& scheme, bool* optimized,
+    /// Searches for replacement of maximal block of elements starting from @startIndex
+    /// Returns false if block couldn't be implemented cheaper or ends before @dirtyIndex
+    /// (such block was examined before)
+    bool findResynthesisReplacement(const OptScheme& scheme, uint startIndex, uint dirtyIndex,
+        uint* blockSize, vector<ReverseElement>* replacement);
+
+    /// General optimization function for duplicates, merge, reduce and transfer optimization
+    /// @regions and @pass - see removeDuplicates(), if regions are null, all elements are dirty.
+    /// Windows with dirty elements are optimized concurrently, then their changed parts
+    /// are put back to @scheme
+    void generalOptimization(OptScheme* scheme, bool* optimized,
         SelectionFunc selectFunc, SwapFunc swapFunc,
-        bool searchPairFromEnd, bool lessComplexityRequired, bool useNeighborElements = true);
+        bool searchPairFromEnd, bool lessComplexityRequired, bool useNeighborElements = true,
+        DirtyRegions* regions = 0, OptimizationPass pass = opMerge);
 
-    enum FullSchemeType
-    {
-        fstSimple,
-        fstRecursive,
-        fstToffoli,
-    };
+    /// Cuts scheme with @schemeSize elements into windows of @subSchemeSize elements, the first
+    /// window has @offset elements, if offset is not zero; only windows with elements from
+    /// @dirtyRanges are stored to @windows, indices of their first dirty elements are stored
+    /// to @firstDirtyIndices
+    static void splitScheme(const vector<Range>& dirtyRanges, uint schemeSize, uint offset,
+        uint subSchemeSize, vector<Range>* windows, vector<uint>* firstDirtyIndices);
 
     OptScheme getFullScheme(const OptScheme& scheme, FullSchemeType type, bool heavyRight = true);
     OptScheme getFinalSchemeImplementation(const OptScheme& scheme);
 
-    /// Returns true in optimizationSucceeded param if optimization tactics
-    /// succeeded and result scheme has less gate complexity
-    OptScheme tryOptimizationTactics(const OptScheme& scheme, SelectionFunc selectionFunc, SwapFunc swapFunc,
-        bool* optimizationSucceeded, bool searchPairFromEnd,
-        bool lessComplexityRequired, int* startIndex = 0, bool useNeighborElements = true);
+    /// Kind of element pairs, which could be selected by selection function
+    enum PairKind
+    {
+        pkAny,
+        pkSameTarget,
+        pkNonCommuting,
+    };
+
+    static PairKind getPairKind(SelectionFunc selectionFunc);
+
+    /// Worklist-driven rewrite engine: applies optimization tactics to @scheme in place until
+    /// none of element pairs could be optimized. Pairs are examined starting from @startIndex,
+    /// after each rewrite only pairs not farther than maxElementsDistanceForOptimization
+    /// from changed elements are examined again.
+    /// Returns true if scheme was changed, changed elements are in [@firstChangedIndex, @changedEndIndex)
+    /// @dag - commutation DAG of @scheme, it is built if null and kept up to date on rewrites
+    bool rewriteScheme(OptScheme* scheme, SelectionFunc selectionFunc, SwapFunc swapFunc,
+        bool searchPairFromEnd, bool lessComplexityRequired, bool useNeighborElements = true,
+        uint startIndex = 0, uint* firstChangedIndex = 0, uint* changedEndIndex = 0,
+        CommutationDag* dag = 0);
+
+    /// Fills @candidates with indices of right elements for pair with left element on @leftIndex
+    void getPairCandidates(const CommutationDag& dag, PairKind pairKind, uint leftIndex,
+        uint elementCount, bool searchPairFromEnd, vector<uint>* candidates);
+
+    /// Checks if elements on @leftIndex and @rightIndex positions could be moved to
+    /// neighbor positions @newLeftIndex and @newRightIndex and optimized there
+    bool findPairPositions(const OptScheme& scheme, const CommutationDag& dag,
+        SelectionFunc selectionFunc, uint leftIndex, uint rightIndex,
+        uint* leftElementMaxTransferIndex, uint* newLeftIndex, uint* newRightIndex);
+
+    /// Replaces two neighbor elements starting from @index with replacements
+    void replacePairInScheme(OptScheme* scheme, uint index,
+        const list<ReverseElement>& leftReplacement, const list<ReverseElement>& rightReplacement);
 
     /// First element - new reverse element obtained as a result of swapping
     /// Second element - range of indices, on which this element is freely swappable
     typedef pair<ReverseElement, Range> SwapResult;
 
-    /// Returns swap result for element on @startIndex position in @scheme.
-    /// Elements in @scheme will be changed accordingly to swap operations, so make backup before using.
-    /// Param @toLeft determines, where this element is moving.
-    deque<SwapResult> getSwapResult(OptScheme* scheme, uint startIndex, bool toLeft);
+    /// Elements of scheme starting from @start, which replace original ones
+    struct SchemePatch
+    {
+        uint start = 0;
+        OptScheme elements;
+    };
+
+    /// Returns swap result for element on @startIndex position in @scheme moving to left
+    /// or to right depending on @toLeft, element is moved only through independent ones.
+    /// Scheme is not changed: if @moved is not null, elements passed by moving element
+    /// are stored to it; if @patch is not null, it is applied to scheme before moving
+    deque<SwapResult> getSwapResult(const OptScheme& scheme, uint startIndex, bool toLeft,
+        SchemePatch* moved = 0, const SchemePatch* patch = 0);
+
+    /// Returns the farthest position of element on @startIndex in swap @result
+    static uint getFarthestPosition(const deque<SwapResult>& result, uint startIndex, bool toLeft);
 
     deque<SwapResult> mergeSwapResults(deque<SwapResult>& toLeft, deque<SwapResult>& toRight);
 
-    /// First element of pair - swap results for left element
-    /// Second element of pair - swap results for right element
-    typedef struct 
+    /// Swap results of elements (merged for both directions) of scheme,
+    /// result is valid only if its stamp equals to the current generation,
+    /// so reset after rewrite doesn't reallocate results
+    struct SwapResultsCache
+    {
+        vector<deque<SwapResult>> results;
+        vector<uint> stamps; //written concurrently for different elements
+        uint generation = 0;
+    };
+
+    static void resetSwapResultsCache(SwapResultsCache* cache, uint elementCount);
+
+    /// Returns swap results of element on @index from @cache, computes them if needed
+    /// Could be called concurrently for different indices
+    const deque<SwapResult>& getCachedSwapResults(const OptScheme& scheme,
+        SwapResultsCache* cache, uint index);
+
+    /// Swap results for left and right elements of pair, they point to cached results
+    /// or to own storage, if moving of one element changes swap results of another one
+    struct SwapResultsPair
+    {
+        const deque<SwapResult>* forLeft;
+        const deque<SwapResult>* forRight;
+
+        unique_ptr<deque<SwapResult>> leftStorage;
+        unique_ptr<deque<SwapResult>> rightStorage;
+    };
+
+    void getSwapResultsPair(const OptScheme& scheme, uint leftIndex, uint rightIndex,
+        SwapResultsCache* cache, SwapResultsPair* pair);
+
+    /// Result of pair search with swap results technique for one right element
+    struct PairPositions
     {
-        deque<SwapResult> forLeft;
-        deque<SwapResult> forRight;
-    } SwapResultsPair;
-        
-    SwapResultsPair getSwapResultsPair(const OptScheme& scheme, uint leftIndex, uint rightIndex);
+        bool found;
+        uint newLeftIndex;
+        uint newRightIndex;
+    };
+
+    /// Swap results technique: checks pairs of element on @leftIndex with all @candidates
+    /// concurrently and stores results to @positions in order of candidates
+    void findSwapResultsPairPositions(const OptScheme& scheme, SelectionFunc selectionFunc,
+        uint leftIndex, const vector<uint>& candidates, SwapResultsCache* cache,
+        vector<PairPositions>* positions);
 
     bool isSwapResultsPairSuiteOptimizationTactics(SelectionFunc selectionFunc,
         const SwapResultsPair& result, uint leftIndex, uint rightIndex,
         uint* newLeftIndex, uint* newRightIndex);
 
-    uint getMaximumTransferIndex(const OptScheme& scheme, const ReverseElement& target,
-        uint startIndex, uint stopIndex) const;
-
     void moveElementInScheme(OptScheme* scheme, uint fromIndex, uint toIndex);
 
     /// This flag is needed on the last optimization step
     /// when none of the negative control inputs are allowed
     bool isNegativeControlInputsAllowed = true;
+
+    Report report;
+    /// Windows of full scheme are optimized concurrently
+    mutex reportMutex;
+
+    bool hasDeadline = false;
+    chrono::steady_clock::time_point deadline;
+    /// Once set, stays set until the end of optimize(), so all passes stop consistently
+    mutable atomic<bool> timeOver {false};
 };
 
 struct PostProcessor::OptimizationParams
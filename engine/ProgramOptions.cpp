@@ -53,10 +53,17 @@ void ProgramOptions::load(const Values& values)
 
     const char* strRmGeneratorWeightThreshold = "rm-generator-weight-threshold";
     const char* strTranspositionsPackSize = "transpositions-pack-size";
+
+    const char* strGtBeamWidth = "gt-beam-width";
+    const char* strGtBeamTimeLimit = "gt-beam-time-limit";
+    const char* strThreadCount = "thread-count";
     
     const char* strDoPostOptimization = "do-post-optimization";
     const char* strMaxElementsDistanceForOptimization = "max-elements-distance-for-optimization";
     const char* strMaxSubSchemeSizeForOptimization = "max-sub-scheme-size-for-optimization";
+    const char* strPostProcessingTimeLimit = "post-processing-time-limit";
+    const char* strTemplateLibrary = "template-library";
+    const char* strTemplateLibraryMaxGateCount = "template-library-max-gate-count";
 
     const char* strEnableTuning = "enable-tuning";
     const char* strEnableDebugBehavior = "enable-debug-behavior";
@@ -72,6 +79,10 @@ void ProgramOptions::load(const Values& values)
     rmGeneratorWeightThreshold = values.getInt(strRmGeneratorWeightThreshold, rmGeneratorWeightThreshold);
     transpositionsPackSize = values.getInt(strTranspositionsPackSize, transpositionsPackSize);
 
+    gtBeamWidth = (uint)values.getInt(strGtBeamWidth, (int)gtBeamWidth);
+    gtBeamTimeLimit = (uint)values.getInt(strGtBeamTimeLimit, (int)gtBeamTimeLimit);
+    threadCount = (uint)values.getInt(strThreadCount, (int)threadCount);
+
     doPostOptimization = values.getBool(strDoPostOptimization, doPostOptimization);
 
     maxElementsDistanceForOptimization = (int)values.getInt(strMaxElementsDistanceForOptimization,
@@ -79,6 +90,12 @@ void ProgramOptions::load(const Values& values)
 
     maxSubSchemeSizeForOptimization = (int)values.getInt(strMaxSubSchemeSizeForOptimization,
         (int)maxSubSchemeSizeForOptimization);
+    postProcessingTimeLimit = (uint)values.getInt(strPostProcessingTimeLimit,
+        (int)postProcessingTimeLimit);
+
+    templateLibraryFile = values.getString(strTemplateLibrary, templateLibraryFile);
+    templateLibraryMaxGateCount = (uint)values.getInt(strTemplateLibraryMaxGateCount,
+        (int)templateLibraryMaxGateCount);
 
     isTuningEnabled = values.getBool(strEnableTuning, isTuningEnabled);
     isDebugBehaviorEnabled = values.getBool(strEnableDebugBehavior, isDebugBehaviorEnabled);
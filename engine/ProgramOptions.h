@@ -41,11 +41,20 @@ public:
     int rmGeneratorWeightThreshold = -1;
     int transpositionsPackSize = 2;
 
+    uint gtBeamWidth = 1;
+    uint gtBeamTimeLimit = 0; //in seconds, 0 means no limit
+
+    uint threadCount = 0; //0 means number of hardware threads
+
     bool isDebugBehaviorEnabled = false;
 
     bool doPostOptimization = true;
     uint maxElementsDistanceForOptimization = 20;
     uint maxSubSchemeSizeForOptimization = 100;
+    uint postProcessingTimeLimit = 0; //in seconds, 0 means no limit
+
+    string templateLibraryFile = ""; //empty means no template optimization
+    uint templateLibraryMaxGateCount = 4;
 
     bool isTuningEnabled = false;
 
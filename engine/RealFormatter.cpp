@@ -0,0 +1,334 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+// static strings
+const char* RealFormatter::strVersionKeyword   = ".version";
+const char* RealFormatter::strNumvarsKeyword   = ".numvars";
+const char* RealFormatter::strVariablesKeyword = ".variables";
+const char* RealFormatter::strBeginKeyword     = ".begin";
+const char* RealFormatter::strEndKeyword       = ".end";
+
+/// Returns true if [begin, end) is equal to @keyword (case insensitive)
+static bool isKeyword(const char* begin, const char* end, const char* keyword)
+{
+    uint length = strlen(keyword);
+    return (uint)(end - begin) == length && _strnicmp(begin, keyword, length) == 0;
+}
+
+/// Skips spaces and returns next token [*begin, *tokenEnd)
+static bool getNextToken(const char** position, const char* end, const char** tokenEnd)
+{
+    const char* current = *position;
+    while (current < end && isspace((unsigned char)*current))
+        ++current;
+
+    const char* last = current;
+    while (last < end && !isspace((unsigned char)*last))
+        ++last;
+
+    *position = current;
+    *tokenEnd = last;
+    return current != last;
+}
+
+//static
+bool RealFormatter::isRealFile(const string& fileName)
+{
+    const char* strExtension = ".real";
+    uint length = strlen(strExtension);
+
+    return fileName.size() > length &&
+        _strnicmp(fileName.c_str() + fileName.size() - length, strExtension, length) == 0;
+}
+
+Scheme RealFormatter::parse(istream& input)
+{
+    Scheme scheme;
+
+    variables = LineNameTable();
+    numvars = 0;
+    hasPendingV = false;
+
+    bool beginParsed = false;
+    bool endParsed = false;
+
+    string line;
+    Gate gate;
+
+    try
+    {
+        while (!endParsed && getline(input, line))
+        {
+            const char* begin = line.c_str();
+            const char* end = begin + line.size();
+
+            // comments are started with '#' and could follow the data
+            end = find(begin, end, '#');
+
+            const char* tokenEnd = 0;
+            if (!getNextToken(&begin, end, &tokenEnd))
+                continue;
+
+            if (*begin == '.')
+            {
+                if (isKeyword(begin, tokenEnd, strBeginKeyword))
+                {
+                    assertFormat(!beginParsed && variables.getCount());
+                    beginParsed = true;
+                }
+                else if (isKeyword(begin, tokenEnd, strEndKeyword))
+                {
+                    assertFormat(beginParsed && !hasPendingV);
+                    endParsed = true;
+                }
+                else
+                {
+                    assertFormat(!beginParsed);
+                    parseHeaderLine(begin, end);
+                }
+            }
+            else
+            {
+                assertFormat(beginParsed);
+                parseGate(begin, end, &gate);
+                appendGate(gate, &scheme);
+            }
+        }
+
+        assertFormat(endParsed);
+    }
+    catch (InvalidFormatException& ex)
+    {
+        ostringstream errorStream;
+        errorStream << "Error: invalid line in REAL file:\n" << line;
+
+        ex.setMessage(errorStream.str());
+        throw ex;
+    }
+
+    return scheme;
+}
+
+uint RealFormatter::getVariablesCount() const
+{
+    return variables.getCount();
+}
+
+void RealFormatter::parseHeaderLine(const char* begin, const char* end)
+{
+    const char* tokenEnd = 0;
+    getNextToken(&begin, end, &tokenEnd);
+
+    if (isKeyword(begin, tokenEnd, strNumvarsKeyword))
+    {
+        begin = tokenEnd;
+        assertFormat(getNextToken(&begin, end, &tokenEnd));
+
+        numvars = 0;
+        for (const char* symbol = begin; symbol < tokenEnd; ++symbol)
+        {
+            assertFormat(isdigit((unsigned char)*symbol) && numvars <= sizeof(word) * 8);
+            numvars = numvars * 10 + (*symbol - '0');
+        }
+    }
+    else if (isKeyword(begin, tokenEnd, strVariablesKeyword))
+    {
+        vector<string> names;
+
+        begin = tokenEnd;
+        while (getNextToken(&begin, end, &tokenEnd))
+        {
+            names.push_back(string(begin, tokenEnd));
+            begin = tokenEnd;
+        }
+
+        assertFormat(names.size() && (!numvars || names.size() == numvars));
+        variables.assign(move(names));
+    }
+
+    // .version, .inputs, .outputs, .constants, .garbage and others are not needed
+}
+
+void RealFormatter::parseGate(const char* begin, const char* end, Gate* gate) const
+{
+    assertd(gate, string("RealFormatter::parseGate(): null ptr"));
+
+    const char* tokenEnd = 0;
+    getNextToken(&begin, end, &tokenEnd);
+
+    // gate type and optional line count: "t3", "f3", "p3", "v", "v+"
+    const char* position = begin;
+    switch (tolower(*position++))
+    {
+    case 't':
+        gate->type = gtToffoli;
+        break;
+
+    case 'f':
+        gate->type = gtFredkin;
+        break;
+
+    case 'p':
+        gate->type = gtPeres;
+        break;
+
+    case 'v':
+        gate->type = gtV;
+        if (position < tokenEnd && *position == '+')
+        {
+            gate->type = gtVPlus;
+            ++position;
+        }
+        break;
+
+    default:
+        throw InvalidFormatException();
+    }
+
+    uint count = 0;
+    bool hasCount = (position < tokenEnd);
+
+    for (; position < tokenEnd; ++position)
+    {
+        assertFormat(isdigit((unsigned char)*position) && count <= sizeof(word) * 8);
+        count = count * 10 + (*position - '0');
+    }
+
+    gate->controlMask = 0;
+    gate->inversionMask = 0;
+    gate->lines.clear();
+
+    word usedMask = 0;
+
+    begin = tokenEnd;
+    while (getNextToken(&begin, end, &tokenEnd))
+    {
+        bool withInversion = (*begin == '-');
+        const char* name = begin + (withInversion ? 1 : 0);
+
+        uint line = variables.find(name, (uint)(tokenEnd - name));
+        assertFormat(line != uintUndefined);
+
+        word mask = (word)1 << line;
+        assertFormat(!(usedMask & mask));
+
+        usedMask |= mask;
+        if (withInversion)
+            gate->inversionMask |= mask;
+
+        gate->lines.push_back(line);
+        begin = tokenEnd;
+    }
+
+    uint lineCount = gate->lines.size();
+    assertFormat(!hasCount || count == lineCount);
+
+    // number of target lines: Fredkin gate has two targets, Peres gate - all but first line
+    uint targetCount = 1;
+    if (gate->type == gtFredkin)
+        targetCount = 2;
+    else if (gate->type == gtPeres)
+        targetCount = lineCount - 1;
+
+    assertFormat(lineCount > targetCount || (lineCount == targetCount && gate->type != gtPeres));
+
+    for (uint index = 0; index < lineCount - targetCount; ++index)
+        gate->controlMask |= (word)1 << gate->lines[index];
+
+    // negative control inputs are supported only for Toffoli and Fredkin gates
+    word targetMask = usedMask & ~gate->controlMask;
+    assertFormat(!(gate->inversionMask & targetMask));
+    assertFormat(!gate->inversionMask || gate->type == gtToffoli || gate->type == gtFredkin);
+}
+
+void RealFormatter::appendGate(const Gate& gate, Scheme* scheme)
+{
+    assertd(scheme, string("RealFormatter::appendGate(): null ptr"));
+
+    uint n = variables.getCount();
+    const vector<uint>& lines = gate.lines;
+    uint lineCount = lines.size();
+
+    if (hasPendingV)
+    {
+        // V gate could be represented only together with the next one on the same lines
+        assertFormat((gate.type == gtV || gate.type == gtVPlus) &&
+            gate.controlMask == pendingV.controlMask && gate.inversionMask == pendingV.inversionMask &&
+            gate.lines.back() == pendingV.lines.back());
+
+        hasPendingV = false;
+        if (gate.type == pendingV.type)
+        {
+            scheme->push_back(ReverseElement(n, (word)1 << lines.back(),
+                gate.controlMask, gate.inversionMask));
+        }
+
+        return;
+    }
+
+    switch (gate.type)
+    {
+    case gtToffoli:
+        scheme->push_back(ReverseElement(n, (word)1 << lines.back(),
+            gate.controlMask, gate.inversionMask));
+        break;
+
+    case gtFredkin:
+        {
+            // swap of x and y: CNOT(y -> x), Toffoli(controls and x -> y), CNOT(y -> x)
+            word x = (word)1 << lines[lineCount - 2];
+            word y = (word)1 << lines[lineCount - 1];
+
+            scheme->push_back(ReverseElement(n, x, y));
+            scheme->push_back(ReverseElement(n, y, gate.controlMask | x, gate.inversionMask));
+            scheme->push_back(ReverseElement(n, x, y));
+        }
+        break;
+
+    case gtPeres:
+        {
+            // i-th line is inverted by conjunction of all previous lines,
+            // starting from the last one, so that controls are not changed yet
+            word controlMask = 0;
+            for (uint index = 0; index + 1 < lineCount; ++index)
+                controlMask |= (word)1 << lines[index];
+
+            for (uint index = lineCount - 1; index > 0; --index)
+            {
+                scheme->push_back(ReverseElement(n, (word)1 << lines[index], controlMask));
+                controlMask &= ~((word)1 << lines[index - 1]);
+            }
+        }
+        break;
+
+    case gtV:
+    case gtVPlus:
+        hasPendingV = true;
+        pendingV = gate;
+        break;
+    }
+}
+
+} //namespace ReversibleLogic
@@ -0,0 +1,83 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Reader of schemes in RevLib .real format.
+/// Input is read line by line into one reusable buffer and gates are parsed in place.
+/// Supported gates: multiple control Toffoli "tN" (negative controls are prefixed with '-'),
+/// Fredkin "fN" and Peres "pN", which are decomposed into Toffoli gates, and pairs of
+/// neighbor "v"/"v+" gates on the same lines (V * V is Toffoli gate, V * V+ is identity).
+/// Single V gates can't be represented by ReverseElement and are reported as invalid.
+/// Only .numvars and .variables are used from header, output labels are ignored.
+class RealFormatter
+{
+public:
+    RealFormatter() = default;
+    virtual ~RealFormatter() = default;
+
+    /// Returns true if @fileName has .real extension
+    static bool isRealFile(const string& fileName);
+
+    Scheme parse(istream& input);
+    uint getVariablesCount() const;
+
+private:
+    enum GateType
+    {
+        gtToffoli,
+        gtFredkin,
+        gtPeres,
+        gtV,
+        gtVPlus,
+    };
+
+    /// Gate in terms of line masks
+    struct Gate
+    {
+        GateType type;
+        word controlMask;
+        word inversionMask;
+        /// Lines in order of appearance (controls and targets)
+        vector<uint> lines;
+    };
+
+    void parseHeaderLine(const char* begin, const char* end);
+    void parseGate(const char* begin, const char* end, Gate* gate) const;
+    void appendGate(const Gate& gate, Scheme* scheme);
+
+    LineNameTable variables;
+    uint numvars = 0;
+
+    /// V gate waiting for the second V gate on the same lines
+    bool hasPendingV = false;
+    Gate pendingV;
+
+    static const char* strVersionKeyword;
+    static const char* strNumvarsKeyword;
+    static const char* strVariablesKeyword;
+    static const char* strBeginKeyword;
+    static const char* strEndKeyword;
+};
+
+} //namespace ReversibleLogic
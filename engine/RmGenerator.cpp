@@ -23,7 +23,8 @@
 namespace ReversibleLogic
 {
 
-RmGenerator::RmGenerator(uint threshold /*= uintUndefined*/)
+template<typename Entry>
+BasicRmGenerator<Entry>::BasicRmGenerator(uint threshold /*= uintUndefined*/)
     : weightThreshold(threshold)
     , pushPolicy()
     , directParams()
@@ -31,7 +32,8 @@ RmGenerator::RmGenerator(uint threshold /*= uintUndefined*/)
 {
 }
 
-void RmGenerator::generate(const TruthTable& inputTable, SynthesisResult* result)
+template<typename Entry>
+void BasicRmGenerator<Entry>::generate(const TruthTable& inputTable, SynthesisResult* result)
 {
     assertd(result, string("RmGenerator::generate(): null ptr"));
 
@@ -64,7 +66,8 @@ void RmGenerator::generate(const TruthTable& inputTable, SynthesisResult* result
     }
 }
 
-TruthTable RmGenerator::invertTable(const TruthTable& directTable) const
+template<typename Entry>
+typename BasicRmGenerator<Entry>::TruthTable BasicRmGenerator<Entry>::invertTable(const TruthTable& directTable) const
 {
     uint size = directTable.size();
 
@@ -72,12 +75,13 @@ TruthTable RmGenerator::invertTable(const TruthTable& directTable) const
     inverseTable.resize(size);
 
     for (uint index = 0; index < size; ++index)
-        inverseTable[directTable[index]] = index;
+        inverseTable[directTable[index]] = (Entry)index;
 
     return inverseTable;
 }
 
-void RmGenerator::initResult(SynthesisResult* result, uint size)
+template<typename Entry>
+void BasicRmGenerator<Entry>::initResult(SynthesisResult* result, uint size)
 {
     assertd(result, string("RmGenerator::initResult(): null ptr"));
 
@@ -85,10 +89,11 @@ void RmGenerator::initResult(SynthesisResult* result, uint size)
     result->rightMultTable.resize(size);
 
     for (uint index = 0; index < size; ++index)
-        result->leftMultTable[index] = result->rightMultTable[index] = index;
+        result->leftMultTable[index] = result->rightMultTable[index] = (Entry)index;
 }
 
-void RmGenerator::initPushPolicy()
+template<typename Entry>
+void BasicRmGenerator<Entry>::initPushPolicy()
 {
     const ProgramOptions& options = ProgramOptions::get();
     if (options.isTuningEnabled)
@@ -113,12 +118,14 @@ void RmGenerator::initPushPolicy()
     }
 }
 
-const RmGenerator::PushPolicy& RmGenerator::getPushPolicy() const
+template<typename Entry>
+const typename BasicRmGenerator<Entry>::PushPolicy& BasicRmGenerator<Entry>::getPushPolicy() const
 {
     return pushPolicy;
 }
 
-void RmGenerator::initSynthesisParams(const TruthTable& inputTable)
+template<typename Entry>
+void BasicRmGenerator<Entry>::initSynthesisParams(const TruthTable& inputTable)
 {
     directParams.table = inputTable;
     directParams.spectra = RmSpectraUtils::calculateSpectra(directParams.table);
@@ -127,7 +134,8 @@ void RmGenerator::initSynthesisParams(const TruthTable& inputTable)
     inverseParams.spectra = RmSpectraUtils::calculateSpectra(inverseParams.table);
 }
 
-void RmGenerator::processAlienSpectraRow(uint n, uint index, const Scheme& scheme,
+template<typename Entry>
+void BasicRmGenerator<Entry>::processAlienSpectraRow(uint n, uint index, const Scheme& scheme,
     Scheme::const_iterator iter, SynthesisResult* result)
 {
     assertd(result, string("RmGenerator::processAlienSpectraRow(): null ptr"));
@@ -154,16 +162,17 @@ void RmGenerator::processAlienSpectraRow(uint n, uint index, const Scheme& schem
     applyPushPolicy(x, y, z, scheme, iter, result);
 
     // modify tables
-    directParams.table[index] = index;
-    directParams.table[z] = y;
+    directParams.table[index] = (Entry)index;
+    directParams.table[z] = (Entry)y;
     directParams.spectra = RmSpectraUtils::calculateSpectra(directParams.table);
 
-    inverseParams.table[index] = index;
-    inverseParams.table[y] = z;
+    inverseParams.table[index] = (Entry)index;
+    inverseParams.table[y] = (Entry)z;
     inverseParams.spectra = RmSpectraUtils::calculateSpectra(inverseParams.table);
 }
 
-void RmGenerator::applyPushPolicy(word x, word y, word z, const Scheme& scheme,
+template<typename Entry>
+void BasicRmGenerator<Entry>::applyPushPolicy(word x, word y, word z, const Scheme& scheme,
     Scheme::const_iterator iter, SynthesisResult* result)
 {
     assertd(result, string("RmGenerator::applyPushPolicy(): null ptr"));
@@ -233,8 +242,9 @@ void RmGenerator::applyPushPolicy(word x, word y, word z, const Scheme& scheme,
     }
 }
 
+template<typename Entry>
 template<typename Iterator>
-word ReversibleLogic::RmGenerator::conjugateValue(word x, Iterator from, Iterator to) const
+word BasicRmGenerator<Entry>::conjugateValue(word x, Iterator from, Iterator to) const
 {
     word y = x;
     while (from != to)
@@ -246,7 +256,8 @@ word ReversibleLogic::RmGenerator::conjugateValue(word x, Iterator from, Iterato
     return y;
 }
 
-void RmGenerator::pushTranpsositionToLeft(const Transposition& transp, SynthesisResult* result)
+template<typename Entry>
+void BasicRmGenerator<Entry>::pushTranpsositionToLeft(const Transposition& transp, SynthesisResult* result)
 {
     assertd(result, string("RmGenerator::pushTranpsositionToRight(): null ptr"));
 
@@ -272,7 +283,8 @@ void RmGenerator::pushTranpsositionToLeft(const Transposition& transp, Synthesis
     swap(table[xIndex], table[yIndex]);
 }
 
-void RmGenerator::pushTranpsositionToRight(const Transposition& transp, SynthesisResult* result)
+template<typename Entry>
+void BasicRmGenerator<Entry>::pushTranpsositionToRight(const Transposition& transp, SynthesisResult* result)
 {
     assertd(result, string("RmGenerator::pushTranpsositionToRight(): null ptr"));
 
@@ -284,7 +296,8 @@ void RmGenerator::pushTranpsositionToRight(const Transposition& transp, Synthesi
     swap(table[x], table[y]);
 }
 
-void RmGenerator::calculatePartialResult(SynthesisParams* params, uint n, uint index)
+template<typename Entry>
+void BasicRmGenerator<Entry>::calculatePartialResult(SynthesisParams* params, uint n, uint index)
 {
     assertd(params, string("RmGenerator::calculatePartialResult(): null ptr"));
     params->elements.resize(0);
@@ -303,7 +316,8 @@ void RmGenerator::calculatePartialResult(SynthesisParams* params, uint n, uint i
     params->spectraCost = RmSpectraUtils::calculateCost(params->spectra);
 }
 
-void RmGenerator::processFirstSpectraRow(SynthesisParams* params, uint n)
+template<typename Entry>
+void BasicRmGenerator<Entry>::processFirstSpectraRow(SynthesisParams* params, uint n)
 {
     word row = params->spectra.front();
 
@@ -324,7 +338,8 @@ void RmGenerator::processFirstSpectraRow(SynthesisParams* params, uint n)
     params->spectra[0] = 0;
 }
 
-void RmGenerator::processVariableSpectraRow(SynthesisParams* params, uint n, uint index)
+template<typename Entry>
+void BasicRmGenerator<Entry>::processVariableSpectraRow(SynthesisParams* params, uint n, uint index)
 {
     word row = params->spectra[index];
     if ((row & index) == 0)
@@ -357,7 +372,8 @@ void RmGenerator::processVariableSpectraRow(SynthesisParams* params, uint n, uin
     }
 }
 
-void RmGenerator::processNonVariableSpectraRow(SynthesisParams* params, uint n, uint index)
+template<typename Entry>
+void BasicRmGenerator<Entry>::processNonVariableSpectraRow(SynthesisParams* params, uint n, uint index)
 {
     word row = params->spectra[index];
 
@@ -417,8 +433,9 @@ void RmGenerator::processNonVariableSpectraRow(SynthesisParams* params, uint n,
     params->spectra = RmSpectraUtils::calculateSpectra(params->table);
 }
 
+template<typename Entry>
 template<typename TableType>
-void RmGenerator::applyTransformation(TableType* tablePtr, word targetMask, word controlMask /*= 0*/)
+void BasicRmGenerator<Entry>::applyTransformation(TableType* tablePtr, word targetMask, word controlMask /*= 0*/)
 {
     assertd(tablePtr, string("RmGenerator::applyTransformation(): null ptr"));
 
@@ -432,11 +449,12 @@ void RmGenerator::applyTransformation(TableType* tablePtr, word targetMask, word
     {
         word value = table[index];
         if ((value & controlMask) == controlMask)
-            table[index] = value ^ targetMask;
+            table[index] = (typename TableType::value_type)(value ^ targetMask);
     }
 }
 
-bool RmGenerator::isInverseParamsBetter() const
+template<typename Entry>
+bool BasicRmGenerator<Entry>::isInverseParamsBetter() const
 {
     bool isBetter = false;
 
@@ -455,7 +473,8 @@ bool RmGenerator::isInverseParamsBetter() const
     return isBetter;
 }
 
-deque<ReversibleLogic::ReverseElement>::iterator RmGenerator::implementPartialResult(Scheme* scheme,
+template<typename Entry>
+deque<ReversibleLogic::ReverseElement>::iterator BasicRmGenerator<Entry>::implementPartialResult(Scheme* scheme,
     deque<ReversibleLogic::ReverseElement>::iterator iter)
 {
     assertd(scheme, string("RmGenerator::implementPartialResult(): null ptr"));
@@ -479,8 +498,9 @@ deque<ReversibleLogic::ReverseElement>::iterator RmGenerator::implementPartialRe
     return iter;
 }
 
+template<typename Entry>
 template<typename Iterator>
-Scheme::iterator ReversibleLogic::RmGenerator::updateScheme(Scheme* scheme,
+Scheme::iterator BasicRmGenerator<Entry>::updateScheme(Scheme* scheme,
     Scheme::iterator iter, Iterator from, Iterator to)
 {
     Scheme::iterator localIter = iter;
@@ -490,4 +510,9 @@ Scheme::iterator ReversibleLogic::RmGenerator::updateScheme(Scheme* scheme,
     return localIter;
 }
 
+// packed truth tables, word is one of these types
+template class BasicRmGenerator<uint16_t>;
+template class BasicRmGenerator<uint32_t>;
+template class BasicRmGenerator<uint64_t>;
+
 } //namespace ReversibleLogic
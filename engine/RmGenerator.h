@@ -23,13 +23,18 @@
 namespace ReversibleLogic
 {
 
-class RmGenerator
+/// Generator works with truth tables, which entries have @Entry type
+template<typename Entry>
+class BasicRmGenerator
 {
 public:
+    typedef BasicTruthTable<Entry> TruthTable;
+    typedef BasicRmSpectra<Entry> RmSpectra;
+
     /// @threshold - spectra rows with indices, which weight greater than this value,
     /// would not be processed
-    explicit RmGenerator(uint threshold = uintUndefined);
-    virtual ~RmGenerator() = default;
+    explicit BasicRmGenerator(uint threshold = uintUndefined);
+    virtual ~BasicRmGenerator() = default;
 
     struct SynthesisResult
     {
@@ -107,4 +112,6 @@ private:
     uint weightThreshold;
 };
 
+typedef BasicRmGenerator<word> RmGenerator;
+
 } //namespace ReversibleLogic
\ No newline at end of file
@@ -24,13 +24,14 @@ namespace ReversibleLogic
 {
 
 //static
-RmSpectra RmSpectraUtils::calculateSpectra(const TruthTable& table)
+template<typename Entry>
+BasicRmSpectra<Entry> RmSpectraUtils::calculateSpectra(const BasicTruthTable<Entry>& table)
 {
     uint size = table.size();
     assertd(countNonZeroBits(size) == 1,
         string("RmSpectraUtils::calculateRmSpectra(): truth table size should be power of two"));
 
-    RmSpectra spectra = table;
+    BasicRmSpectra<Entry> spectra = table;
     auto spectraPtr = spectra.data();
 
     for (uint step = 1; step < size; step <<= 1)
@@ -71,7 +72,8 @@ word RmSpectraUtils::getRowOfIdentSpectra(uint index)
 }
 
 //static
-bool RmSpectraUtils::isSpectraRowIdent(const RmSpectra& spectra, uint index)
+template<typename Entry>
+bool RmSpectraUtils::isSpectraRowIdent(const BasicRmSpectra<Entry>& spectra, uint index)
 {
     return isSpectraRowIdent(spectra[index], index);
 }
@@ -82,7 +84,9 @@ bool RmSpectraUtils::isSpectraRowIdent(word row, uint index)
     return row == getRowOfIdentSpectra(index);
 }
 
-uint RmSpectraUtils::calculateCost(const RmSpectra& spectra)
+//static
+template<typename Entry>
+uint RmSpectraUtils::calculateCost(const BasicRmSpectra<Entry>& spectra)
 {
     uint cost = 0;
     uint size = spectra.size();
@@ -98,4 +102,16 @@ uint RmSpectraUtils::calculateCost(const RmSpectra& spectra)
     return cost;
 }
 
+// packed truth tables, word is one of these types
+#define INSTANTIATE_RM_SPECTRA_UTILS(Entry) \
+    template BasicRmSpectra<Entry> RmSpectraUtils::calculateSpectra(const BasicTruthTable<Entry>&); \
+    template bool RmSpectraUtils::isSpectraRowIdent(const BasicRmSpectra<Entry>&, uint); \
+    template uint RmSpectraUtils::calculateCost(const BasicRmSpectra<Entry>&);
+
+INSTANTIATE_RM_SPECTRA_UTILS(uint16_t)
+INSTANTIATE_RM_SPECTRA_UTILS(uint32_t)
+INSTANTIATE_RM_SPECTRA_UTILS(uint64_t)
+
+#undef INSTANTIATE_RM_SPECTRA_UTILS
+
 } //namespace ReversibleLogic
\ No newline at end of file
@@ -23,13 +23,18 @@
 namespace ReversibleLogic
 {
 
-typedef vector<word> RmSpectra;
+/// Reed-Muller spectra has the same entry type as truth table
+template<typename Entry>
+using BasicRmSpectra = BasicTruthTable<Entry>;
+
+typedef BasicRmSpectra<word> RmSpectra;
 
 class RmSpectraUtils
 {
 public:
     /// Returns Reed-Muller spectra for input truth @table
-    static RmSpectra calculateSpectra(const TruthTable& table);
+    template<typename Entry>
+    static BasicRmSpectra<Entry> calculateSpectra(const BasicTruthTable<Entry>& table);
 
     static bool isVariableRow(uint index);
 
@@ -37,11 +42,13 @@ public:
     static word getRowOfIdentSpectra(uint index);
 
     /// Returns true if @row in spectra equals to row with the same index in RM-spectra of identity function
-    static bool isSpectraRowIdent(const RmSpectra& spectra, uint index);
+    template<typename Entry>
+    static bool isSpectraRowIdent(const BasicRmSpectra<Entry>& spectra, uint index);
     static bool isSpectraRowIdent(word row, uint index);
 
     /// Returns cost of Reed-Muller spectra
-    static uint calculateCost(const RmSpectra& spectra);
+    template<typename Entry>
+    static uint calculateCost(const BasicRmSpectra<Entry>& spectra);
 };
 
 } //namespace ReversibleLogic
\ No newline at end of file
@@ -24,7 +24,8 @@ namespace ReversibleLogic
 {
 
 //static
-uint SchemeUtils::calculateQuantumCost(const Scheme& scheme)
+template<typename Container>
+uint SchemeUtils::calculateQuantumCost(const Container& scheme)
 {
     uint size = scheme.size();
 
@@ -151,6 +152,115 @@ uint SchemeUtils::getElementQuantumCost(const ReverseElement& element)
     return cost;
 }
 
+//static
+template<typename Container>
+uint SchemeUtils::calculateDepth(const Container& scheme, vector<uint>* criticalPath /* = 0 */)
+{
+    if (criticalPath)
+        criticalPath->clear();
+
+    uint size = scheme.size();
+    if (size == 0)
+        return 0;
+
+    uint n = scheme.front().getInputCount();
+
+    // for each line: depth of the last element on this line and its index
+    vector<uint> lineDepths(n, 0);
+    vector<uint> lineElements(n, uintUndefined);
+
+    // for each element: previous element on the critical path to it
+    vector<uint> predecessors;
+    if (criticalPath)
+        predecessors.resize(size, uintUndefined);
+
+    uint depth = 0;
+    uint lastElementIndex = uintUndefined;
+
+    for (uint index = 0; index < size; ++index)
+    {
+        word lines = getElementLines(scheme[index]);
+
+        uint layer = 0;
+        uint predecessor = uintUndefined;
+
+        for (uint line = 0; line < n; ++line)
+        {
+            if ((lines & ((word)1 << line)) && lineDepths[line] > layer)
+            {
+                layer = lineDepths[line];
+                predecessor = lineElements[line];
+            }
+        }
+
+        ++layer;
+        for (uint line = 0; line < n; ++line)
+        {
+            if (lines & ((word)1 << line))
+            {
+                lineDepths[line] = layer;
+                lineElements[line] = index;
+            }
+        }
+
+        if (criticalPath)
+            predecessors[index] = predecessor;
+
+        if (layer > depth)
+        {
+            depth = layer;
+            lastElementIndex = index;
+        }
+    }
+
+    if (criticalPath)
+    {
+        criticalPath->reserve(depth);
+        for (uint index = lastElementIndex; index != uintUndefined; index = predecessors[index])
+            criticalPath->push_back(index);
+
+        reverse(criticalPath->begin(), criticalPath->end());
+    }
+
+    return depth;
+}
+
+//static
+word SchemeUtils::getElementLines(const ReverseElement& element)
+{
+    if (!element.isIndependent())
+    {
+        // dependent element depends on values of all lines
+        return getFullMask(element.getInputCount());
+    }
+
+    return element.getTargetMask() | element.getControlMask();
+}
+
+//static
+template<typename Container>
+vector<bool> SchemeUtils::getPeresGateFlags(const Container& scheme)
+{
+    vector<bool> flags(scheme.size(), false);
+
+    bool isPreviousElementWasUsedBefore = true;
+    for (uint index = 0; index < scheme.size(); ++index)
+    {
+        uint peresCost = 0;
+        if (!isPreviousElementWasUsedBefore &&
+            isPeresGate(scheme[index - 1], scheme[index], &peresCost))
+        {
+            flags[index] = true;
+            isPreviousElementWasUsedBefore = true;
+            continue;
+        }
+
+        isPreviousElementWasUsedBefore = false;
+    }
+
+    return flags;
+}
+
 bool SchemeUtils::isPeresGate(const ReverseElement& left, const ReverseElement& right, uint* cost)
 {
     assertd(cost, string("SchemeUtils::isPeresGate(): null ptr"));
@@ -207,4 +317,15 @@ bool SchemeUtils::isPeresGate(const ReverseElement& left, const ReverseElement&
     return true;
 }
 
+// schemes are stored in deques, schemes being optimized - in vectors
+#define INSTANTIATE_SCHEME_UTILS(Container) \
+    template uint SchemeUtils::calculateQuantumCost(const Container&); \
+    template uint SchemeUtils::calculateDepth(const Container&, vector<uint>*); \
+    template vector<bool> SchemeUtils::getPeresGateFlags(const Container&);
+
+INSTANTIATE_SCHEME_UTILS(Scheme)
+INSTANTIATE_SCHEME_UTILS(vector<ReverseElement>)
+
+#undef INSTANTIATE_SCHEME_UTILS
+
 } //namespace ReversibleLogic
@@ -26,10 +26,27 @@ namespace ReversibleLogic
 class SchemeUtils
 {
 public:
-    static uint calculateQuantumCost(const Scheme& scheme);
+    /// @Container is Scheme or vector of elements, same for calculateDepth()
+    template<typename Container>
+    static uint calculateQuantumCost(const Container& scheme);
 
-private:
     static uint getElementQuantumCost(const ReverseElement& element);
+
+    /// Returns number of layers of elements acting on disjoint lines, computed in linear time.
+    /// If criticalPath is not null, it is filled with indices of elements (in scheme order)
+    /// forming the longest chain of elements, which determines the depth
+    template<typename Container>
+    static uint calculateDepth(const Container& scheme, vector<uint>* criticalPath = 0);
+
+    /// Returns mask of lines, the element acts on (all lines for dependent element)
+    static word getElementLines(const ReverseElement& element);
+
+    /// Returns flags of elements, which form Peres gate with previous element of @scheme,
+    /// elements are paired the same way as in calculateQuantumCost()
+    template<typename Container>
+    static vector<bool> getPeresGateFlags(const Container& scheme);
+
+private:
     static bool isPeresGate(const ReverseElement& left, const ReverseElement& right, uint* cost);
 };
 
@@ -0,0 +1,145 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+SchemeWriter::SchemeWriter(ostream& out, Format format, vector<string> lineNames)
+    : out(out)
+    , format(format)
+    , lineNames(move(lineNames))
+    , buffer(numBufferSize)
+{
+}
+
+SchemeWriter::~SchemeWriter()
+{
+    flush();
+}
+
+void SchemeWriter::write(const char* text)
+{
+    append(text, strlen(text));
+}
+
+void SchemeWriter::write(const string& text)
+{
+    append(text.data(), text.size());
+}
+
+void SchemeWriter::write(char symbol)
+{
+    append(symbol);
+}
+
+void SchemeWriter::writeElement(const ReverseElement& element)
+{
+    word controlMask = element.getControlMask();
+    word inversionMask = element.getInversionMask();
+    uint count = countNonZeroBits(controlMask) + 1; //plus target line
+
+    append('t');
+    appendNumber(count);
+    append(' ');
+
+    for (uint index = 0; controlMask; ++index, controlMask >>= 1, inversionMask >>= 1)
+    {
+        if (!(controlMask & 1))
+            continue;
+
+        assertd(index < lineNames.size(), string("SchemeWriter: wrong line index"));
+        const string& name = lineNames[index];
+
+        if (format == wfTfc)
+        {
+            append(name.data(), name.size());
+            if (inversionMask & 1)
+                append('\'');
+
+            append(',');
+        }
+        else
+        {
+            if (inversionMask & 1)
+                append('-');
+
+            append(name.data(), name.size());
+            append(' ');
+        }
+    }
+
+    uint targetIndex = findPositiveBitPosition(element.getTargetMask());
+    assertd(targetIndex < lineNames.size(), string("SchemeWriter: wrong line index"));
+
+    const string& name = lineNames[targetIndex];
+    append(name.data(), name.size());
+    append('\n');
+}
+
+void SchemeWriter::flush()
+{
+    if (bufferSize)
+        out.write(buffer.data(), bufferSize);
+
+    bufferSize = 0;
+}
+
+void SchemeWriter::append(const char* text, uint size)
+{
+    if (bufferSize + size > numBufferSize)
+    {
+        flush();
+
+        if (size > numBufferSize)
+        {
+            out.write(text, size);
+            return;
+        }
+    }
+
+    memcpy(buffer.data() + bufferSize, text, size);
+    bufferSize += size;
+}
+
+void SchemeWriter::append(char symbol)
+{
+    if (bufferSize == numBufferSize)
+        flush();
+
+    buffer[bufferSize++] = symbol;
+}
+
+void SchemeWriter::appendNumber(uint value)
+{
+    char digits[16];
+    uint count = sizeof(digits);
+
+    do
+    {
+        digits[--count] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+
+    append(digits + count, sizeof(digits) - count);
+}
+
+} //namespace ReversibleLogic
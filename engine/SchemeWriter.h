@@ -0,0 +1,73 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Buffered writer of schemes in text formats (TFC and RevLib .real).
+/// Text is formatted into reusable buffer without allocations using precomputed
+/// line names, buffer is written to the stream in big blocks.
+class SchemeWriter : public GateSink
+{
+public:
+    enum Format
+    {
+        wfTfc,
+        wfReal,
+    };
+
+    /// @lineNames - names of lines, i-th name is used for i-th line of elements
+    SchemeWriter(ostream& out, Format format, vector<string> lineNames);
+    virtual ~SchemeWriter();
+
+    void write(const char* text);
+    void write(const string& text);
+    void write(char symbol);
+
+    /// Writes line with element: "t3 a,b',c" for TFC, "t3 a1 -a2 a3" for .real
+    virtual void writeElement(const ReverseElement& element);
+
+    /// Writes buffered text to the stream
+    void flush();
+
+private:
+    SchemeWriter(const SchemeWriter&) = delete;
+    SchemeWriter& operator=(const SchemeWriter&) = delete;
+
+    enum
+    {
+        numBufferSize = 1 << 20,
+    };
+
+    void append(const char* text, uint size);
+    void append(char symbol);
+    void appendNumber(uint value);
+
+    ostream& out;
+    Format format;
+    vector<string> lineNames;
+
+    vector<char> buffer;
+    uint bufferSize = 0;
+};
+
+} //namespace ReversibleLogic
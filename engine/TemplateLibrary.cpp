@@ -0,0 +1,517 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+static const char strTemplateLibraryMagic[4] = { 'R', 'L', 'T', 'L' };
+static const uint32_t numTemplateLibraryVersion = 1;
+
+//static
+const TemplateLibrary& TemplateLibrary::get()
+{
+    static TemplateLibrary library;
+    static once_flag loadFlag;
+
+    call_once(loadFlag, []()
+    {
+        const string& fileName = ProgramOptions::get().templateLibraryFile;
+        if (!fileName.empty())
+            library.load(fileName);
+    });
+
+    return library;
+}
+
+//static
+uint TemplateLibrary::build(uint maxGateCount, const string& fileName)
+{
+    assert(maxGateCount > 0 && maxGateCount <= numMaxGateCount,
+        string("TemplateLibrary::build(): invalid max gate count"));
+
+    struct Circuit
+    {
+        Gate gates[numMaxGateCount];
+        uint gateCount;
+        uint cost;
+    };
+
+    vector<Gate> allGates = getAllGates();
+    vector<uint> gateCosts;
+    for (auto gate : allGates)
+    {
+        ReverseElement element(numLineCount, (word)1 << getTarget(gate),
+            getControlMask(gate), getInversionMask(gate));
+
+        gateCosts.push_back(SchemeUtils::getElementQuantumCost(element));
+    }
+
+    // breadth-first search over canonical forms, circuit with less quantum cost
+    // is preferred among circuits with the same gate count
+    unordered_map<TruthTable, Circuit> circuits;
+    vector<TruthTable> frontier;
+
+    Circuit empty;
+    empty.gateCount = 0;
+    empty.cost = 0;
+    circuits[getIdentity()] = empty;
+    frontier.push_back(getIdentity());
+
+    uint allGateCount = allGates.size();
+    for (uint gateCount = 1; gateCount <= maxGateCount; ++gateCount)
+    {
+        vector<TruthTable> nextFrontier;
+        for (auto table : frontier)
+        {
+            Circuit circuit = circuits[table];
+            for (uint gateIndex = 0; gateIndex < allGateCount; ++gateIndex)
+            {
+                Gate gate = allGates[gateIndex];
+
+                Relabeling relabeling;
+                TruthTable key = canonicalize(applyGate(table, gate), &relabeling);
+
+                auto iter = circuits.find(key);
+                uint cost = circuit.cost + gateCosts[gateIndex];
+                if (iter != circuits.end() &&
+                    (iter->second.gateCount < gateCount || iter->second.cost <= cost))
+                {
+                    continue;
+                }
+
+                Circuit next;
+                next.gateCount = gateCount;
+                next.cost = cost;
+                for (uint index = 0; index < circuit.gateCount; ++index)
+                    next.gates[index] = relabelGate(circuit.gates[index], relabeling);
+
+                next.gates[gateCount - 1] = relabelGate(gate, relabeling);
+
+                if (iter == circuits.end())
+                {
+                    circuits[key] = next;
+                    nextFrontier.push_back(key);
+                }
+                else
+                    iter->second = next;
+            }
+        }
+
+        frontier.swap(nextFrontier);
+    }
+
+    // hash table with load factor at most 0.5
+    uint64_t slotCount = 1;
+    while (slotCount < 2 * circuits.size())
+        slotCount <<= 1;
+
+    Entry emptyEntry;
+    emptyEntry.key = 0;
+    for (auto& gate : emptyEntry.gates)
+        gate = gateUndefined;
+
+    vector<Entry> slots((size_t)slotCount, emptyEntry);
+    for (auto& item : circuits)
+    {
+        const Circuit& circuit = item.second;
+
+#if defined(DEBUG)
+        TruthTable check = getIdentity();
+        for (uint index = 0; index < circuit.gateCount; ++index)
+            check = applyGate(check, circuit.gates[index]);
+
+        assertd(check == item.first, string("TemplateLibrary::build(): invalid circuit"));
+#endif //DEBUG
+
+        uint64_t slot = getSlot(item.first, slotCount);
+        while (slots[(size_t)slot].key)
+            slot = (slot + 1) & (slotCount - 1);
+
+        Entry& entry = slots[(size_t)slot];
+        entry.key = item.first;
+        for (uint index = 0; index < circuit.gateCount; ++index)
+            entry.gates[index] = circuit.gates[index];
+    }
+
+    Header header;
+    memcpy(header.magic, strTemplateLibraryMagic, sizeof(header.magic));
+    header.version = numTemplateLibraryVersion;
+    header.lineCount = numLineCount;
+    header.maxGateCount = maxGateCount;
+    header.slotCount = slotCount;
+    header.entryCount = circuits.size();
+
+    ofstream output(fileName, ios_base::out | ios_base::binary);
+    assert(output.is_open(),
+        string("Failed to open template library file \"") + fileName + "\" for writing");
+
+    output.write((const char*)&header, sizeof(header));
+    output.write((const char*)slots.data(), slots.size() * sizeof(Entry));
+    output.close();
+
+    return circuits.size();
+}
+
+void TemplateLibrary::load(const string& fileName)
+{
+    header = 0;
+    entries = 0;
+
+    assert(file.open(fileName),
+        string("Failed to open template library file \"") + fileName + "\" for reading");
+
+    string error = string("Invalid template library file \"") + fileName + "\"";
+    if (file.getSize() < sizeof(Header))
+        throw InvalidFormatException(move(error));
+
+    const Header* fileHeader = (const Header*)file.getData();
+    uint64_t slotCount = fileHeader->slotCount;
+
+    if (memcmp(fileHeader->magic, strTemplateLibraryMagic, sizeof(fileHeader->magic)) ||
+        fileHeader->version != numTemplateLibraryVersion ||
+        fileHeader->lineCount != numLineCount ||
+        fileHeader->maxGateCount > numMaxGateCount ||
+        slotCount == 0 || (slotCount & (slotCount - 1)) ||
+        file.getSize() != sizeof(Header) + slotCount * sizeof(Entry))
+    {
+        file.close();
+        throw InvalidFormatException(move(error));
+    }
+
+    header = fileHeader;
+    entries = (const Entry*)(fileHeader + 1);
+}
+
+bool TemplateLibrary::isLoaded() const
+{
+    return header != 0;
+}
+
+uint TemplateLibrary::getEntryCount() const
+{
+    return (header ? (uint)header->entryCount : 0);
+}
+
+uint TemplateLibrary::getMaxGateCount() const
+{
+    return (header ? header->maxGateCount : 0);
+}
+
+//static
+TemplateLibrary::Gate TemplateLibrary::makeGate(uint target, uint controlMask, uint inversionMask)
+{
+    return (Gate)(target | (controlMask << 4) | (inversionMask << 8));
+}
+
+//static
+uint TemplateLibrary::getTarget(Gate gate)
+{
+    return gate & 0x3;
+}
+
+//static
+uint TemplateLibrary::getControlMask(Gate gate)
+{
+    return (gate >> 4) & 0xF;
+}
+
+//static
+uint TemplateLibrary::getInversionMask(Gate gate)
+{
+    return (gate >> 8) & 0xF;
+}
+
+//static
+TemplateLibrary::TruthTable TemplateLibrary::getIdentity()
+{
+    return 0xFEDCBA9876543210ull;
+}
+
+//static
+TemplateLibrary::TruthTable TemplateLibrary::applyGate(TruthTable table, Gate gate)
+{
+    uint targetMask = 1 << getTarget(gate);
+    uint controlMask = getControlMask(gate);
+    uint inversionMask = getInversionMask(gate);
+
+    // gate is applied after function of table
+    TruthTable result = 0;
+    for (uint index = 0; index < numValueCount; ++index)
+    {
+        uint shift = index << 2;
+        uint value = (table >> shift) & 0xF;
+        if (((value ^ inversionMask) & controlMask) == controlMask)
+            value ^= targetMask;
+
+        result |= (TruthTable)value << shift;
+    }
+
+    return result;
+}
+
+//static
+TemplateLibrary::TruthTable TemplateLibrary::canonicalize(TruthTable table, Relabeling* relabeling)
+{
+    assertd(relabeling, string("TemplateLibrary::canonicalize(): null ptr"));
+
+    const vector<RelabelingInfo>& relabelings = getRelabelings();
+
+    TruthTable best = (TruthTable)(-1);
+    for (auto& info : relabelings)
+    {
+        // relabeled function maps values[x] to values[table(x)]
+        TruthTable relabeled = 0;
+        for (uint index = 0; index < numValueCount; ++index)
+        {
+            uint value = (table >> (index << 2)) & 0xF;
+            relabeled |= (TruthTable)info.values[value] << (info.values[index] << 2);
+        }
+
+        if (relabeled < best)
+        {
+            best = relabeled;
+            *relabeling = info.lines;
+        }
+    }
+
+    return best;
+}
+
+bool TemplateLibrary::findCircuit(TruthTable table, vector<Gate>* circuit) const
+{
+    assertd(circuit, string("TemplateLibrary::findCircuit(): null ptr"));
+
+    circuit->clear();
+    if (!header)
+        return false;
+
+    Relabeling relabeling;
+    TruthTable key = canonicalize(table, &relabeling);
+
+    uint64_t slotCount = header->slotCount;
+    uint64_t slot = getSlot(key, slotCount);
+    while (entries[slot].key && entries[slot].key != key)
+        slot = (slot + 1) & (slotCount - 1);
+
+    const Entry& entry = entries[slot];
+    if (!entry.key)
+        return false;
+
+    // gates of entry are expressed in canonical lines, return them back
+    Relabeling inverse;
+    for (uint index = 0; index < numLineCount; ++index)
+        inverse[relabeling[index]] = (uint8_t)index;
+
+    for (auto gate : entry.gates)
+    {
+        if (gate == gateUndefined)
+            break;
+
+        circuit->push_back(relabelGate(gate, inverse));
+    }
+
+    return true;
+}
+
+bool TemplateLibrary::findCircuit(TruthTable table, uint maxPrefixGateCount,
+    vector<Gate>* circuit) const
+{
+    assertd(circuit, string("TemplateLibrary::findCircuit(): null ptr"));
+
+    if (findCircuit(table, circuit))
+        return true;
+
+    if (!header)
+        return false;
+
+    // table = rest * prefix, so rest = table * inverse(prefix)
+    vector<Gate> rest;
+    uint bestGateCount = uintUndefined;
+    uint prefixGateCount = 0;
+
+    for (auto& prefix : getPrefixes())
+    {
+        if (prefix.gateCount > maxPrefixGateCount)
+            break;
+
+        // circuits with longer prefix are not better than already found one
+        if (prefix.gateCount > prefixGateCount && bestGateCount != uintUndefined)
+            break;
+
+        prefixGateCount = prefix.gateCount;
+
+        TruthTable restTable = 0;
+        for (uint index = 0; index < numValueCount; ++index)
+        {
+            uint shift = index << 2;
+            uint value = (prefix.inverse >> shift) & 0xF;
+            restTable |= ((table >> (value << 2)) & 0xF) << shift;
+        }
+
+        if (!findCircuit(restTable, &rest) || rest.size() + prefix.gateCount >= bestGateCount)
+            continue;
+
+        bestGateCount = rest.size() + prefix.gateCount;
+
+        circuit->assign(prefix.gates, prefix.gates + prefix.gateCount);
+        circuit->insert(circuit->end(), rest.cbegin(), rest.cend());
+    }
+
+    return bestGateCount != uintUndefined;
+}
+
+//static
+const vector<TemplateLibrary::RelabelingInfo>& TemplateLibrary::getRelabelings()
+{
+    static const vector<RelabelingInfo> relabelings = []()
+    {
+        vector<RelabelingInfo> result;
+
+        Relabeling lines;
+        for (uint index = 0; index < numLineCount; ++index)
+            lines[index] = (uint8_t)index;
+
+        do
+        {
+            RelabelingInfo info;
+            info.lines = lines;
+
+            for (uint value = 0; value < numValueCount; ++value)
+            {
+                uint relabeled = 0;
+                for (uint index = 0; index < numLineCount; ++index)
+                {
+                    if (value & (1 << index))
+                        relabeled |= 1 << lines[index];
+                }
+
+                info.values[value] = (uint8_t)relabeled;
+            }
+
+            result.push_back(info);
+        } while (next_permutation(lines.begin(), lines.end()));
+
+        return result;
+    }();
+
+    return relabelings;
+}
+
+//static
+const vector<TemplateLibrary::Prefix>& TemplateLibrary::getPrefixes()
+{
+    static const vector<Prefix> prefixes = []()
+    {
+        vector<Prefix> result;
+        unordered_set<TruthTable> inverses;
+        inverses.insert(getIdentity());
+
+        // gates are involutions, so inverse of prefix is the prefix in reverse order
+        vector<Gate> allGates = getAllGates();
+        for (auto gate : allGates)
+        {
+            Prefix prefix;
+            prefix.inverse = applyGate(getIdentity(), gate);
+            prefix.gates[0] = gate;
+            prefix.gateCount = 1;
+
+            if (inverses.insert(prefix.inverse).second)
+                result.push_back(prefix);
+        }
+
+        for (auto first : allGates)
+        {
+            for (auto second : allGates)
+            {
+                Prefix prefix;
+                prefix.inverse = applyGate(applyGate(getIdentity(), second), first);
+                prefix.gates[0] = first;
+                prefix.gates[1] = second;
+                prefix.gateCount = 2;
+
+                if (inverses.insert(prefix.inverse).second)
+                    result.push_back(prefix);
+            }
+        }
+
+        return result;
+    }();
+
+    return prefixes;
+}
+
+//static
+vector<TemplateLibrary::Gate> TemplateLibrary::getAllGates()
+{
+    // each control line could be absent, straight or inverted
+    vector<Gate> gates;
+    for (uint target = 0; target < numLineCount; ++target)
+    {
+        uint freeMask = ((1 << numLineCount) - 1) ^ (1 << target);
+        for (uint controlMask = 0; controlMask <= freeMask; ++controlMask)
+        {
+            if ((controlMask & freeMask) != controlMask)
+                continue;
+
+            for (uint inversionMask = 0; inversionMask <= controlMask; ++inversionMask)
+            {
+                if ((inversionMask & controlMask) == inversionMask)
+                    gates.push_back(makeGate(target, controlMask, inversionMask));
+            }
+        }
+    }
+
+    return gates;
+}
+
+//static
+TemplateLibrary::Gate TemplateLibrary::relabelGate(Gate gate, const Relabeling& relabeling)
+{
+    uint controlMask = getControlMask(gate);
+    uint inversionMask = getInversionMask(gate);
+
+    uint newControlMask = 0;
+    uint newInversionMask = 0;
+    for (uint index = 0; index < numLineCount; ++index)
+    {
+        uint mask = 1 << index;
+        uint newMask = 1 << relabeling[index];
+
+        if (controlMask & mask)
+            newControlMask |= newMask;
+
+        if (inversionMask & mask)
+            newInversionMask |= newMask;
+    }
+
+    return makeGate(relabeling[getTarget(gate)], newControlMask, newInversionMask);
+}
+
+//static
+uint64_t TemplateLibrary::getSlot(TruthTable key, uint64_t slotCount)
+{
+    uint64_t hash = key * 0x9E3779B97F4A7C15ull;
+    hash ^= hash >> 32;
+    return hash & (slotCount - 1);
+}
+
+}   // namespace ReversibleLogic
@@ -0,0 +1,143 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Library of circuits with minimal number of gates for all functions of up to 4 lines,
+/// which could be implemented with at most maxGateCount gates.
+/// Functions are stored up to line relabeling: key of entry is the minimal truth table
+/// among all relabelings of function (canonical form).
+/// Library is built offline by build() and loaded from memory mapped binary file by load(),
+/// entries are stored in open addressing hash table right in the file.
+class TemplateLibrary
+{
+public:
+    enum
+    {
+        numLineCount = 4,
+        numValueCount = 1 << numLineCount,
+        numMaxGateCount = 4,
+        numMaxWindowSize = 8,
+    };
+
+    /// Gate on local lines: bits 0-1 - target line, bits 4-7 - control mask,
+    /// bits 8-11 - inversion mask (negative control inputs)
+    typedef uint16_t Gate;
+
+    /// Truth table of function of local lines: i-th nibble is image of i
+    typedef uint64_t TruthTable;
+
+    /// i-th element is new index of i-th line
+    typedef array<uint8_t, numLineCount> Relabeling;
+
+    TemplateLibrary() = default;
+    virtual ~TemplateLibrary() = default;
+
+    /// Returns library loaded from file specified in "template-library" option,
+    /// library is not loaded if option is empty
+    static const TemplateLibrary& get();
+
+    /// Builds library of circuits with up to @maxGateCount gates and writes it to @fileName
+    /// Returns number of library entries
+    static uint build(uint maxGateCount, const string& fileName);
+
+    void load(const string& fileName);
+    bool isLoaded() const;
+
+    uint getEntryCount() const;
+    uint getMaxGateCount() const;
+
+    static Gate makeGate(uint target, uint controlMask, uint inversionMask);
+    static uint getTarget(Gate gate);
+    static uint getControlMask(Gate gate);
+    static uint getInversionMask(Gate gate);
+
+    static TruthTable getIdentity();
+    static TruthTable applyGate(TruthTable table, Gate gate);
+
+    /// Returns canonical form of @table, @relabeling maps lines of @table to lines of canonical form
+    static TruthTable canonicalize(TruthTable table, Relabeling* relabeling);
+
+    /// Finds minimal circuit for @table, gates of @circuit are expressed in lines of @table
+    /// Returns false if there is no such circuit in library
+    bool findCircuit(TruthTable table, vector<Gate>* circuit) const;
+
+    /// Same as findCircuit(), but if there is no circuit for @table in library, searches for
+    /// circuit, which is library circuit preceded by up to @maxPrefixGateCount gates
+    /// (meet in the middle), so circuits with up to maxGateCount + 2 gates could be found
+    bool findCircuit(TruthTable table, uint maxPrefixGateCount, vector<Gate>* circuit) const;
+
+private:
+    TemplateLibrary(const TemplateLibrary&) = delete;
+    TemplateLibrary& operator=(const TemplateLibrary&) = delete;
+
+    enum : uint16_t
+    {
+        gateUndefined = 0xFFFF,
+    };
+
+    /// Layout of library file: header, then slotCount entries
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t lineCount;
+        uint32_t maxGateCount;
+        uint64_t slotCount;
+        uint64_t entryCount;
+    };
+
+    /// Empty slot has zero key (no truth table of permutation could be zero)
+    struct Entry
+    {
+        TruthTable key;
+        Gate gates[numMaxGateCount];
+    };
+
+    /// Line relabeling with corresponding mapping of values
+    struct RelabelingInfo
+    {
+        Relabeling lines;
+        uint8_t values[numValueCount];
+    };
+
+    /// Gates in the beginning of circuit and truth table of inverse function
+    struct Prefix
+    {
+        TruthTable inverse;
+        Gate gates[2];
+        uint gateCount;
+    };
+
+    static const vector<RelabelingInfo>& getRelabelings();
+    static const vector<Prefix>& getPrefixes();
+    static vector<Gate> getAllGates();
+    static Gate relabelGate(Gate gate, const Relabeling& relabeling);
+    static uint64_t getSlot(TruthTable key, uint64_t slotCount);
+
+    MappedFile file;
+    const Header* header = 0;
+    const Entry* entries = 0;
+};
+
+}   // namespace ReversibleLogic
@@ -43,20 +43,6 @@ TfcFormatter::TfcFormatter(uint n, uint m, unordered_map<uint, uint> outputVaria
         string("TfcFormatter(): wrong number and/or order of output variables"));
 }
 
-string TfcFormatter::getVariableName(uint value) const
-{
-    const char cBegin = 'a';
-    const char cEnd = 'z';
-
-    assert(value < cEnd - cBegin, string("getVariableName(): argument out of range"));
-    char name = cBegin + (char)value;
-
-    string result;
-    result.push_back(name);
-
-    return result;
-}
-
 Scheme TfcFormatter::parse(istream& stream)
 {
     Scheme scheme;
@@ -213,19 +199,11 @@ void TfcFormatter::checkMarker(Markers* markers, MarkerType type) const
 
 void TfcFormatter::parseVariables(const string& line)
 {
-    string variables = line.substr(strlen(strVariablesPrefix));
-    vector<string> parts = split(variables, ',');
-
-    int count = (int)parts.size();
-    assertFormat(count);
-
-    for (int index = 0; index < count; ++index)
-    {
-        const string& key = parts[index];
-        assertFormat(variableToIndexMap.find(key) == variableToIndexMap.cend());
+    string names = line.substr(strlen(strVariablesPrefix));
+    vector<string> parts = split(names, ',');
 
-        variableToIndexMap[key] = index;
-    }
+    assertFormat(parts.size());
+    variables.assign(move(parts));
 }
 
 void TfcFormatter::parseElement(const string& line, Scheme* scheme) const
@@ -236,75 +214,95 @@ void TfcFormatter::parseElement(const string& line, Scheme* scheme) const
     assertd(line.size() > 3 && (line.front() == 't' || line.front() == 'T'),
         string("TfcFormatter::parseElement(): wrong toffolyelement line"));
 
-    string temp = line.substr(1); //skip 't'
-    uint size = temp.size();
+    const char* position = line.c_str() + 1; //skip 't'
+    const char* end = line.c_str() + line.size();
+
+    while (end > position && isspace((unsigned char)*(end - 1)))
+        --end;
 
-    size_t spacePos = 0;
-    int count = stoi(temp, &spacePos);
+    uint count = 0;
+    const char* countBegin = position;
 
-    while (spacePos < size && isspace(temp.at(spacePos)))
-        ++spacePos;
-    
-    assertFormat(spacePos != size);
+    while (position < end && isdigit((unsigned char)*position) && count <= variables.getCount())
+        count = count * 10 + (*position++ - '0');
 
-    string controls = temp.substr(spacePos);
-    vector<string> parts = split(controls, ',');
+    assertFormat(position != countBegin && count && count <= variables.getCount());
 
-    assertFormat(parts.size() == count);
+    while (position < end && isspace((unsigned char)*position))
+        ++position;
 
-    // parse control inputs
+    assertFormat(position != end);
+
+    // parse control inputs and target line, names are looked up without copying
     word controlMask = 0;
     word inversionMask = 0;
+    word targetMask = 0;
 
-    for (int index = 0; index < count - 1; ++index)
+    for (uint index = 0; index < count; ++index)
     {
-        string control = parts[index];
-        assertFormat(control.size());
+        bool isTarget = (index + 1 == count);
 
-        bool withInversion = (control.back() == '\'');
-        if (withInversion)
-            control.pop_back();
+        const char* nameEnd = find(position, end, ',');
+        assertFormat((nameEnd == end) == isTarget);
 
-        assertFormat(variableToIndexMap.find(control) != variableToIndexMap.cend());
+        bool withInversion = (nameEnd > position && *(nameEnd - 1) == '\'');
+        uint length = (uint)(nameEnd - position) - (withInversion ? 1 : 0);
 
-        int controlIndex = variableToIndexMap.at(control);
-        word mask = (word)1 << controlIndex;
+        uint lineIndex = variables.find(position, length);
+        assertFormat(length && lineIndex != uintUndefined);
 
-        controlMask |= mask;
-        if (withInversion)
-            inversionMask |= mask;
-    }
-
-    // parse target line
-    string target = parts.back();
-    assertFormat(target.size() && target.back() != '\'' &&
-        variableToIndexMap.find(target) != variableToIndexMap.cend());
+        word mask = (word)1 << lineIndex;
+        if (isTarget)
+        {
+            assertFormat(!withInversion);
+            targetMask = mask;
+        }
+        else
+        {
+            controlMask |= mask;
+            if (withInversion)
+                inversionMask |= mask;
+        }
 
-    int targetIndex = variableToIndexMap.at(target);
-    word targetMask = (word)1 << targetIndex;
+        position = (isTarget ? end : nameEnd + 1);
+    }
 
-    ReverseElement element(variableToIndexMap.size(), targetMask, controlMask, inversionMask);
+    ReverseElement element(variables.getCount(), targetMask, controlMask, inversionMask);
     scheme->push_back(element);
 }
 
 uint TfcFormatter::getVariablesCount() const
 {
-    return variableToIndexMap.size();
+    return variables.getCount();
 }
 
-void TfcFormatter::fillIndexToVariableMap(uint n)
+void TfcFormatter::writeHeader(ostream& out, uint n)
 {
-    if (variableToIndexMap.size() == 0)
-    {
-        for (uint index = 0; index < n; ++index)
-        {
-            string name = getVariableName(index);
-            variableToIndexMap[name] = (int)index;
-        }
-    }
+    prepareVariables(n);
 
-    for (const auto& iter : variableToIndexMap)
-        indexToVariableMap[iter.second] = iter.first;
+    writeVariablesLine(out);
+    writeInputLine(out);
+    writeOutputLine(out);
+    writeConstantsLine(out);
+
+    writeBegin(out);
+}
+
+void TfcFormatter::writeFooter(ostream& out) const
+{
+    out << reorderingSubscheme;
+    writeEnd(out);
+}
+
+const vector<string>& TfcFormatter::getLineNames() const
+{
+    return variables.getNames();
+}
+
+void TfcFormatter::prepareVariables(uint n)
+{
+    if (variables.getCount() == 0)
+        variables.assignDefault(n);
 }
 
 void TfcFormatter::writeVariablesLine(ostream& out) const
@@ -318,13 +316,13 @@ void TfcFormatter::writeInputLine(ostream& out) const
         writeHeaderLine(out, strInputsPrefix);
     else if (hasSpecificInputOutputs)
     {
-        assert(inputCount <= indexToVariableMap.size(),
+        assert(inputCount <= variables.getCount(),
             string("TfcFormatter::writeInputLine(): wrong number of input variables"));
 
         out << strInputsPrefix;
         for (uint index = 0; index < inputCount; ++index)
         {
-            out << indexToVariableMap.at((int)index);
+            out << variables.getName(index);
             if (index != inputCount - 1)
                 out << ',';
         }
@@ -341,7 +339,7 @@ void TfcFormatter::writeOutputLine(ostream& out)
         writeHeaderLine(out, strOutputsPrefix);
     else if (hasSpecificInputOutputs)
     {
-        assert(outputCount <= indexToVariableMap.size(),
+        assert(outputCount <= variables.getCount(),
             string("TfcFormatter::writeOutputLine(): wrong number of output variables"));
 
         const ProgramOptions& options = ProgramOptions::get();
@@ -351,7 +349,7 @@ void TfcFormatter::writeOutputLine(ostream& out)
         out << strOutputsPrefix;
         for (uint index = 0; index < outputCount; ++index)
         {
-            out << indexToVariableMap.at((int)outputVariablesOrder.at((int)index));
+            out << variables.getName(outputVariablesOrder.at((int)index));
             if (index != outputCount - 1)
                 out << ',';
         }
@@ -406,9 +404,9 @@ void TfcFormatter::sortOutputVariablesOrder()
 
         swap(indices[i], indices[yIndex]);
 
-        strStream << "t2 " << indexToVariableMap[(int)i] << ',' << indexToVariableMap[(int)yIndex] << endl;
-        strStream << "t2 " << indexToVariableMap[(int)yIndex] << ',' << indexToVariableMap[(int)i] << endl;
-        strStream << "t2 " << indexToVariableMap[(int)i] << ',' << indexToVariableMap[(int)yIndex] << endl;
+        strStream << "t2 " << variables.getName(i) << ',' << variables.getName(yIndex) << endl;
+        strStream << "t2 " << variables.getName(yIndex) << ',' << variables.getName(i) << endl;
+        strStream << "t2 " << variables.getName(i) << ',' << variables.getName(yIndex) << endl;
     }
 
     reorderingSubscheme = strStream.str();
@@ -423,7 +421,7 @@ void TfcFormatter::writeConstantsLine(ostream& out) const
         out << constantsLine << endl;
     else if (hasSpecificInputOutputs)
     {
-        uint count = indexToVariableMap.size() - inputCount;
+        uint count = variables.getCount() - inputCount;
         if (count > 0)
         {
             out << strConstantsPrefix;
@@ -443,10 +441,10 @@ void TfcFormatter::writeHeaderLine(ostream& out, const char* prefix) const
 {
     out << prefix;
 
-    uint varCount = indexToVariableMap.size();
+    uint varCount = variables.getCount();
     for (uint index = 0; index < varCount; ++index)
     {
-        out << indexToVariableMap.at((int)index);
+        out << variables.getName(index);
         if (index != varCount - 1)
             out << ',';
     }
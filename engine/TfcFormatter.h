@@ -36,9 +36,13 @@ public:
     template<typename Container>
     void format(ostream& out, const Container& scheme);
 
-private:
-    string getVariableName(uint value) const;
+    /// Streaming formatting: header is written for scheme with @n lines,
+    /// then elements are written by SchemeWriter with getLineNames(), then footer
+    void writeHeader(ostream& out, uint n);
+    void writeFooter(ostream& out) const;
+    const vector<string>& getLineNames() const;
 
+private:
     /// Parsing methods
     enum MarkerType
     {
@@ -75,7 +79,8 @@ private:
     void parseElement(const string& line, Scheme* scheme) const;
 
     /// Formatting methods
-    void fillIndexToVariableMap(uint n);
+    /// Default variable names are used for @n lines, if variables were not parsed
+    void prepareVariables(uint n);
 
     void writeVariablesLine(ostream& out) const;
     void writeInputLine(ostream& out) const;
@@ -90,11 +95,7 @@ private:
     void writeBegin(ostream& out) const;
     void writeEnd(ostream& out) const;
 
-    template<typename Container>
-    void writeMainBody(ostream& out, const Container& scheme) const;
-
-    unordered_map<string, int> variableToIndexMap;
-    unordered_map<int, string> indexToVariableMap;
+    LineNameTable variables;
 
     bool hasSpecificInputOutputs = false;
 
@@ -129,54 +130,12 @@ void ReversibleLogic::TfcFormatter::format(ostream& out, const Container& scheme
         n = scheme.front().getInputCount();
     }
 
-    fillIndexToVariableMap(n);
-
-    writeVariablesLine(out);
-    writeInputLine(out);
-    writeOutputLine(out);
-    writeConstantsLine(out);
-
-    writeBegin(out);
-    writeMainBody(out, scheme);
-    writeEnd(out);
-}
-
-template<typename Container>
-void ReversibleLogic::TfcFormatter::writeMainBody(ostream& out, const Container& scheme) const
-{
-    for (const ReverseElement& element : scheme)
+    writeHeader(out, n);
     {
-        word controlMask = element.getControlMask();
-        word inversionMask = element.getInversionMask();
-        uint count = countNonZeroBits(controlMask) + 1; //plus target line
-
-        out << 't' << count << ' ';
-
-        uint index = 0;
-        uint mask = 1;
-
-        while (mask <= controlMask)
-        {
-            if (controlMask & mask)
-            {
-                out << indexToVariableMap.at((int)index);
-                if (inversionMask & mask)
-                    out << '\'';
-
-                out << ',';
-            }                
-
-            ++index;
-            mask <<= 1;
-        }
-
-        word targetMask = element.getTargetMask();
-        uint targetIndex = findPositiveBitPosition(targetMask);
-
-        out << indexToVariableMap.at((int)targetIndex) << endl;
+        SchemeWriter writer(out, SchemeWriter::wfTfc, variables.getNames());
+        writer.writeElements(scheme);
     }
-
-    out << reorderingSubscheme;
+    writeFooter(out);
 }
 
 } //namespace ReversibleLogic
\ No newline at end of file
@@ -0,0 +1,197 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+/// True for threads, which are executing tasks of some pool right now
+static thread_local bool isInsidePoolTask = false;
+
+ThreadPool::ThreadPool(uint threadCount /* = 0 */)
+    : threadCount(threadCount)
+{
+    if (!this->threadCount)
+        this->threadCount = thread::hardware_concurrency();
+
+    if (!this->threadCount)
+        this->threadCount = 1;
+
+    ranges = unique_ptr<Range[]>(new Range[this->threadCount]);
+    for (uint index = 0; index < this->threadCount; ++index)
+    {
+        ranges[index].next = 0;
+        ranges[index].end = 0;
+    }
+
+    // calling thread is worker with index 0
+    workers.reserve(this->threadCount - 1);
+    for (uint index = 1; index < this->threadCount; ++index)
+        workers.push_back(thread(&ThreadPool::workerLoop, this, index));
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> lock(poolMutex);
+        stopFlag = true;
+    }
+
+    startCondition.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+}
+
+//static
+ThreadPool& ThreadPool::get()
+{
+    static ThreadPool pool(ProgramOptions::get().threadCount);
+    return pool;
+}
+
+uint ThreadPool::getThreadCount() const
+{
+    return threadCount;
+}
+
+void ThreadPool::parallelFor(uint count, const function<void(uint)>& task)
+{
+    if (!count)
+        return;
+
+    if (threadCount == 1 || count == 1 || isInsidePoolTask)
+    {
+        for (uint index = 0; index < count; ++index)
+            task(index);
+
+        return;
+    }
+
+    lock_guard<mutex> callLock(callMutex);
+
+    // split indices between workers
+    uint step = count / threadCount;
+    uint rest = count % threadCount;
+    uint start = 0;
+
+    for (uint index = 0; index < threadCount; ++index)
+    {
+        uint size = step + (index < rest);
+
+        ranges[index].next = start;
+        ranges[index].end = start + size;
+
+        start += size;
+    }
+
+    {
+        lock_guard<mutex> lock(poolMutex);
+
+        currentTask = &task;
+        firstError = exception_ptr();
+
+        activeWorkerCount = threadCount - 1;
+        ++generation;
+    }
+
+    startCondition.notify_all();
+    runTasks(0);
+
+    exception_ptr error;
+    {
+        unique_lock<mutex> lock(poolMutex);
+        finishCondition.wait(lock, [&]() { return activeWorkerCount == 0; });
+
+        currentTask = 0;
+        error = firstError;
+    }
+
+    if (error)
+        rethrow_exception(error);
+}
+
+void ThreadPool::workerLoop(uint workerIndex)
+{
+    uint lastGeneration = 0;
+    while (true)
+    {
+        {
+            unique_lock<mutex> lock(poolMutex);
+            startCondition.wait(lock, [&]() { return stopFlag || generation != lastGeneration; });
+
+            if (stopFlag)
+                break;
+
+            lastGeneration = generation;
+        }
+
+        runTasks(workerIndex);
+
+        {
+            lock_guard<mutex> lock(poolMutex);
+            --activeWorkerCount;
+        }
+
+        finishCondition.notify_one();
+    }
+}
+
+void ThreadPool::runTasks(uint workerIndex)
+{
+    isInsidePoolTask = true;
+
+    // own range first, then steal from others
+    for (uint offset = 0; offset < threadCount; ++offset)
+    {
+        uint rangeIndex = (workerIndex + offset) % threadCount;
+
+        uint index = takeIndex(rangeIndex);
+        while (index != uintUndefined)
+        {
+            try
+            {
+                (*currentTask)(index);
+            }
+            catch (...)
+            {
+                lock_guard<mutex> lock(poolMutex);
+                if (!firstError)
+                    firstError = current_exception();
+            }
+
+            index = takeIndex(rangeIndex);
+        }
+    }
+
+    isInsidePoolTask = false;
+}
+
+uint ThreadPool::takeIndex(uint rangeIndex)
+{
+    Range& range = ranges[rangeIndex];
+    if (range.next.load() >= range.end)
+        return uintUndefined;
+
+    uint index = range.next.fetch_add(1);
+    return (index < range.end ? index : uintUndefined);
+}
+
+} //namespace ReversibleLogic
@@ -0,0 +1,82 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Pool of worker threads for data-parallel loops
+/// Each worker gets its own contiguous range of indices and steals
+/// indices from ranges of other workers, when its own range is exhausted
+class ThreadPool
+{
+public:
+    /// @threadCount - total number of threads including the calling one,
+    /// 0 means number of hardware threads
+    explicit ThreadPool(uint threadCount = 0);
+    virtual ~ThreadPool();
+
+    /// Returns shared pool with thread count from program options
+    static ThreadPool& get();
+
+    uint getThreadCount() const;
+
+    /// Calls @task(index) for each index in [0, count) and waits for completion
+    /// The first exception thrown by a task is rethrown in the calling thread
+    /// Nested calls (from inside of a task) are executed sequentially
+    void parallelFor(uint count, const function<void(uint)>& task);
+
+private:
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void workerLoop(uint workerIndex);
+    void runTasks(uint workerIndex);
+
+    /// Returns next index from range of @rangeIndex or uintUndefined
+    uint takeIndex(uint rangeIndex);
+
+    struct Range
+    {
+        atomic<uint> next;
+        uint end;
+    };
+
+    uint threadCount;
+    vector<thread> workers;
+    unique_ptr<Range[]> ranges;
+
+    mutex poolMutex;
+    condition_variable startCondition;
+    condition_variable finishCondition;
+
+    uint generation = 0;
+    uint activeWorkerCount = 0;
+    bool stopFlag = false;
+
+    const function<void(uint)>* currentTask = 0;
+    exception_ptr firstError;
+
+    /// Serializes parallelFor() calls from different threads
+    mutex callMutex;
+};
+
+} //namespace ReversibleLogic
@@ -22,19 +22,19 @@
 
 void Timer::start()
 {
-    startTime = clock();
+    startTime = chrono::steady_clock::now();
 }
 
 void Timer::stop()
 {
-    endTime = clock();
+    endTime = chrono::steady_clock::now();
 }
 
 float Timer::getElapsedMs() const
 {
     float elapsedTime = 0;
     if( endTime > startTime )
-        elapsedTime = 1000.0f * (endTime - startTime) / CLOCKS_PER_SEC;
+        elapsedTime = chrono::duration<float, milli>(endTime - startTime).count();
 
     return elapsedTime;
 }
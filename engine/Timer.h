@@ -32,8 +32,9 @@ public:
     float getElapsedMs() const;
 
 private:
-    clock_t startTime = 0;
-    clock_t endTime = 0;
+    // wall-clock time: CPU time is misleading for multi-threaded code
+    chrono::steady_clock::time_point startTime;
+    chrono::steady_clock::time_point endTime;
 };
 
 class AutoTimer
@@ -24,7 +24,6 @@ namespace ReversibleLogic
 {
 
 Transposition::Transposition(word left, word right, bool needSort /* = false */)
-    : empty(false)
 {
     if(left == right)
     {
@@ -42,16 +41,9 @@ Transposition::Transposition(word left, word right, bool needSort /* = false */)
         sort();
 }
 
-Transposition::Transposition(const Transposition& another)
-    : x(another.x)
-    , y(another.y)
-    , empty(another.empty)
-{
-}
-
 bool Transposition::isEmpty() const
 {
-    return empty;
+    return x == y;
 }
 
 void Transposition::sort()
@@ -71,7 +63,6 @@ void Transposition::swap()
 void Transposition::setX(word value)
 {
     x = value;
-    empty = false;
 }
 
 word Transposition::getX() const
@@ -82,7 +73,6 @@ word Transposition::getX() const
 void Transposition::setY(word value)
 {
     y = value;
-    empty = false;
 }
 
 word Transposition::getY() const
@@ -23,15 +23,15 @@
 namespace ReversibleLogic
 {
 
+/// Transposition takes 16 bytes (no virtual methods), so it can be stored
+/// compactly in TranspositionArena and copied as plain data
 class Transposition
 {
 public:
     Transposition() = default;
     explicit Transposition(word left, word right, bool needSort = false);
-    Transposition(const Transposition& another);
-
-    virtual ~Transposition() = default;
 
+    /// Default constructed transposition (x == y) is empty
     bool isEmpty() const;
 
     /// Sort x and y by they weights
@@ -67,8 +67,6 @@ public:
 private:
     word x = 0;
     word y = 0;
-
-    bool empty = true;
 };
 
 }   // namespace ReversibleLogic
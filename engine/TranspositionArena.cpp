@@ -0,0 +1,154 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+//////////////////////////////////////////////////////////////////////////
+// class TranspositionSpan
+
+TranspositionSpan::TranspositionSpan(TranspositionArena* arena, uint offset, uint count)
+    : arena(arena)
+    , offset(offset)
+    , count(count)
+{
+}
+
+uint TranspositionSpan::size() const
+{
+    return count;
+}
+
+bool TranspositionSpan::empty() const
+{
+    return count == 0;
+}
+
+Transposition* TranspositionSpan::begin() const
+{
+    return (arena ? arena->getData() + offset : 0);
+}
+
+Transposition* TranspositionSpan::end() const
+{
+    return begin() + count;
+}
+
+Transposition& TranspositionSpan::front() const
+{
+    assertd(count, string("TranspositionSpan::front(): empty span"));
+    return *begin();
+}
+
+Transposition& TranspositionSpan::back() const
+{
+    assertd(count, string("TranspositionSpan::back(): empty span"));
+    return *(end() - 1);
+}
+
+Transposition& TranspositionSpan::operator[](uint index) const
+{
+    assertd(index < count, string("TranspositionSpan: index out of range"));
+    return *(begin() + index);
+}
+
+uint TranspositionSpan::getOffset() const
+{
+    return offset;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// class TranspositionArena
+
+uint TranspositionArena::getPosition() const
+{
+    return storage.size();
+}
+
+void TranspositionArena::rewind(uint position)
+{
+    assertd(position <= storage.size(), string("TranspositionArena::rewind(): invalid position"));
+    storage.resize(position);
+}
+
+void TranspositionArena::reset()
+{
+    // capacity is kept for the next step
+    storage.clear();
+}
+
+void TranspositionArena::push(const Transposition& transp)
+{
+    storage.push_back(transp);
+}
+
+void TranspositionArena::push(word x, word y)
+{
+    storage.push_back(Transposition(x, y));
+}
+
+TranspositionSpan TranspositionArena::makeSpan(uint position)
+{
+    assertd(position <= storage.size(), string("TranspositionArena::makeSpan(): invalid position"));
+    return TranspositionSpan(this, position, storage.size() - position);
+}
+
+TranspositionSpan TranspositionArena::copy(const TranspositionSpan& source)
+{
+    uint position = storage.size();
+    uint count = source.size();
+
+    // source may point to this arena, so don't use iterators after reallocation
+    storage.resize(position + count);
+    for (uint index = 0; index < count; ++index)
+        storage[position + index] = source[index];
+
+    return makeSpan(position);
+}
+
+TranspositionSpan TranspositionArena::relocate(const TranspositionSpan& source, uint position)
+{
+    uint offset = source.getOffset();
+    uint count = source.size();
+
+    if (!count)
+    {
+        rewind(position);
+        return makeSpan(position);
+    }
+
+    assertd(position <= offset && offset + count <= storage.size(),
+        string("TranspositionArena::relocate(): invalid span"));
+
+    if (position != offset)
+        move(storage.begin() + offset, storage.begin() + offset + count, storage.begin() + position);
+
+    storage.resize(position + count);
+    return makeSpan(position);
+}
+
+Transposition* TranspositionArena::getData()
+{
+    return storage.data();
+}
+
+} //namespace ReversibleLogic
@@ -0,0 +1,92 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+class TranspositionArena;
+
+/// Non-owning view of contiguous transpositions stored in TranspositionArena
+/// View stays valid until arena is rewound or reset below its end
+class TranspositionSpan
+{
+public:
+    TranspositionSpan() = default;
+    TranspositionSpan(TranspositionArena* arena, uint offset, uint count);
+
+    uint size() const;
+    bool empty() const;
+
+    /// For range-based for loop
+    Transposition* begin() const;
+    Transposition* end() const;
+
+    Transposition& front() const;
+    Transposition& back() const;
+
+    Transposition& operator[](uint index) const;
+
+    /// Returns offset of the first transposition in arena
+    uint getOffset() const;
+
+private:
+    TranspositionArena* arena = 0;
+    uint offset = 0;
+    uint count = 0;
+};
+
+/// Stack-like storage for all transpositions of one reduction step
+/// Temporary spans are dropped with rewind(), all spans at once with reset()
+class TranspositionArena
+{
+public:
+    TranspositionArena() = default;
+    virtual ~TranspositionArena() = default;
+
+    /// Returns current end of arena, could be used later for rewind() or makeSpan()
+    uint getPosition() const;
+
+    /// Drops all transpositions after @position
+    void rewind(uint position);
+
+    /// Drops all transpositions
+    void reset();
+
+    void push(const Transposition& transp);
+    void push(word x, word y);
+
+    /// Returns span of all transpositions pushed after @position
+    TranspositionSpan makeSpan(uint position);
+
+    /// Appends copy of @source to the end of arena
+    TranspositionSpan copy(const TranspositionSpan& source);
+
+    /// Moves @source down to @position and drops everything after it
+    TranspositionSpan relocate(const TranspositionSpan& source, uint position);
+
+    Transposition* getData();
+
+private:
+    vector<Transposition> storage;
+};
+
+} //namespace ReversibleLogic
@@ -0,0 +1,410 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+/// Tables with more inputs don't fit in memory anyway
+static const uint numMaxInputCount = 32;
+
+/// Number of entries filled by one task
+static const word numChunkSize = 1 << 16;
+
+/// Primitive polynomials of GF(2^k) for k in [2, 16], index is k
+static const word gf2PrimitivePolynomials[] =
+{
+    0, 0, 0x7, 0xB, 0x13, 0x25, 0x43, 0x83, 0x11D, 0x211,
+    0x409, 0x805, 0x1053, 0x201B, 0x4443, 0x8003, 0x1100B,
+};
+
+/// Fills table of function with @inputCount inputs in parallel, @func is called for each input
+template<typename Entry, typename Func>
+static void fillTable(BasicTruthTable<Entry>* table, uint inputCount, Func func)
+{
+    assert(inputCount <= numMaxInputCount,
+        string("Truth table generator: too many inputs: ") + to_string(inputCount));
+
+    word size = (word)1 << inputCount;
+    table->resize((size_t)size);
+
+    Entry* entries = table->data();
+    uint chunkCount = (uint)((size + numChunkSize - 1) / numChunkSize);
+
+    ThreadPool::get().parallelFor(chunkCount, [&](uint index)
+    {
+        word begin = (word)index * numChunkSize;
+        word end = min(begin + numChunkSize, size);
+
+        for (word x = begin; x < end; ++x)
+            entries[x] = (Entry)func(x);
+    });
+}
+
+static void checkArgument(bool condition, const char* name, uint value)
+{
+    assert(condition, string("Truth table generator: wrong argument ") + name + " = " +
+        to_string(value));
+}
+
+// Generators set input and output counts, table is filled only if it isn't null
+
+/// Hidden weighted bit function: input is rotated left by its weight
+template<typename Entry>
+static void generateHwb(const vector<uint>& args, BasicTruthTable<Entry>* table,
+    uint* inputCount, uint* outputCount)
+{
+    uint n = args[0];
+    checkArgument(n > 0, "n", n);
+
+    *inputCount = n;
+    *outputCount = n;
+
+    if (!table)
+        return;
+
+    word mask = getFullMask(n);
+    fillTable(table, n, [n, mask](word x)
+    {
+        uint weight = countNonZeroBits(x);
+        return ((x << weight) | (x >> (n - weight))) & mask;
+    });
+}
+
+/// x-th prime for x in [1, prime count], other inputs are mapped to the rest of outputs
+/// in increasing order to get permutation. This completion differs from the one of RevLib
+/// nth_prime*_inc tables, so results are not comparable. Sieve and completion are sequential.
+template<typename Entry>
+static void generateNthPrimeSorted(const vector<uint>& args, BasicTruthTable<Entry>* table,
+    uint* inputCount, uint* outputCount)
+{
+    uint n = args[0];
+    checkArgument(n > 1 && n <= numMaxInputCount, "n", n);
+
+    *inputCount = n;
+    *outputCount = n;
+
+    if (!table)
+        return;
+
+    word size = (word)1 << n;
+
+    vector<bool> isComposite((size_t)size, false);
+    for (word x = 2; x * x < size; ++x)
+    {
+        if (isComposite[(size_t)x])
+            continue;
+
+        for (word y = x * x; y < size; y += x)
+            isComposite[(size_t)y] = true;
+    }
+
+    table->assign((size_t)size, 0);
+    vector<bool> isUsed((size_t)size, false);
+
+    word x = 1;
+    for (word y = 2; y < size; ++y)
+    {
+        if (!isComposite[(size_t)y])
+        {
+            (*table)[(size_t)x++] = (Entry)y;
+            isUsed[(size_t)y] = true;
+        }
+    }
+
+    word lastPrimeIndex = x;
+    word y = 0;
+
+    for (x = 0; x < size; ++x)
+    {
+        if (x > 0 && x < lastPrimeIndex)
+            continue;
+
+        while (isUsed[(size_t)y])
+            ++y;
+
+        (*table)[(size_t)x] = (Entry)y++;
+    }
+}
+
+/// Multiplication in GF(2^k): input is (a, b), a is in high k bits, output is a * b
+template<typename Entry>
+static void generateGf2Mult(const vector<uint>& args, BasicTruthTable<Entry>* table,
+    uint* inputCount, uint* outputCount)
+{
+    uint k = args[0];
+    uint maxDegree = sizeof(gf2PrimitivePolynomials) / sizeof(gf2PrimitivePolynomials[0]) - 1;
+    checkArgument(k >= 2 && k <= maxDegree, "k", k);
+
+    *inputCount = 2 * k;
+    *outputCount = k;
+
+    if (!table)
+        return;
+
+    word polynomial = gf2PrimitivePolynomials[k];
+    word mask = getFullMask(k);
+
+    fillTable(table, 2 * k, [k, polynomial, mask](word x)
+    {
+        word a = x >> k;
+        word b = x & mask;
+
+        word product = 0;
+        for (uint index = 0; index < k; ++index)
+        {
+            if ((b >> index) & 1)
+                product ^= a << index;
+        }
+
+        for (uint index = 2 * k - 2; index >= k; --index)
+        {
+            if ((product >> index) & 1)
+                product ^= polynomial << (index - k);
+        }
+
+        return product;
+    });
+}
+
+/// Divisibility of n-bit input by m
+template<typename Entry>
+static void generateMod(const vector<uint>& args, BasicTruthTable<Entry>* table,
+    uint* inputCount, uint* outputCount)
+{
+    uint n = args[0];
+    uint m = args[1];
+    checkArgument(n > 0, "n", n);
+    checkArgument(m > 0, "m", m);
+
+    *inputCount = n;
+    *outputCount = 1;
+
+    if (!table)
+        return;
+
+    fillTable(table, n, [m](word x)
+    {
+        return (word)(x % m == 0);
+    });
+}
+
+/// Weight of n-bit input
+template<typename Entry>
+static void generateRd(const vector<uint>& args, BasicTruthTable<Entry>* table,
+    uint* inputCount, uint* outputCount)
+{
+    uint n = args[0];
+    checkArgument(n > 0, "n", n);
+
+    *inputCount = n;
+    *outputCount = getSignificantBitCount(n);
+
+    if (!table)
+        return;
+
+    fillTable(table, n, [](word x)
+    {
+        return (word)countNonZeroBits(x);
+    });
+}
+
+/// Symmetric function: 1 if weight of n-bit input is in [low, high]
+template<typename Entry>
+static void generateSymmetric(const vector<uint>& args, BasicTruthTable<Entry>* table,
+    uint* inputCount, uint* outputCount)
+{
+    uint n = args[0];
+    uint low = args[1];
+    uint high = args[2];
+    checkArgument(n > 0, "n", n);
+    checkArgument(low <= high && high <= n, "high", high);
+
+    *inputCount = n;
+    *outputCount = 1;
+
+    if (!table)
+        return;
+
+    fillTable(table, n, [low, high](word x)
+    {
+        uint weight = countNonZeroBits(x);
+        return (word)(weight >= low && weight <= high);
+    });
+}
+
+template<typename Entry>
+using GeneratorFunc = void(*)(const vector<uint>& args, BasicTruthTable<Entry>* table,
+    uint* inputCount, uint* outputCount);
+
+struct GeneratorInfo
+{
+    const char* name;
+    const char* arguments;
+    const char* description;
+    uint argCount;
+
+    // instances for packed truth tables
+    GeneratorFunc<uint16_t> func16;
+    GeneratorFunc<uint32_t> func32;
+    GeneratorFunc<uint64_t> func64;
+
+    template<typename Entry>
+    GeneratorFunc<Entry> getFunc() const;
+};
+
+template<>
+GeneratorFunc<uint16_t> GeneratorInfo::getFunc<uint16_t>() const
+{
+    return func16;
+}
+
+template<>
+GeneratorFunc<uint32_t> GeneratorInfo::getFunc<uint32_t>() const
+{
+    return func32;
+}
+
+template<>
+GeneratorFunc<uint64_t> GeneratorInfo::getFunc<uint64_t>() const
+{
+    return func64;
+}
+
+#define GENERATOR_FUNCS(func) func<uint16_t>, func<uint32_t>, func<uint64_t>
+
+static const GeneratorInfo generators[] =
+{
+    { "hwb", "n", "hidden weighted bit function", 1, GENERATOR_FUNCS(generateHwb) },
+    { "nth_prime_sorted", "n", "n-bit x-th prime, other outputs in increasing order\n"
+        "        (not the same permutation as nth_prime*_inc tables)", 1,
+        GENERATOR_FUNCS(generateNthPrimeSorted) },
+    { "gf2mult", "k", "multiplication in GF(2^k), k <= 16", 1, GENERATOR_FUNCS(generateGf2Mult) },
+    { "mod", "n:m", "1 if n-bit input is divisible by m", 2, GENERATOR_FUNCS(generateMod) },
+    { "rd", "n", "weight of n-bit input", 1, GENERATOR_FUNCS(generateRd) },
+    { "symmetric", "n:low:high", "1 if weight of n-bit input is in [low, high]", 3,
+        GENERATOR_FUNCS(generateSymmetric) },
+};
+
+#undef GENERATOR_FUNCS
+
+/// Splits @specification to name and arguments
+static const GeneratorInfo& parseSpecification(const string& specification, vector<uint>* args)
+{
+    vector<string> parts;
+    size_t begin = 0;
+    while (true)
+    {
+        size_t end = specification.find(':', begin);
+        parts.push_back(specification.substr(begin, end - begin));
+
+        if (end == string::npos)
+            break;
+
+        begin = end + 1;
+    }
+
+    const GeneratorInfo* info = 0;
+    for (auto& generator : generators)
+    {
+        if (parts.front() == generator.name)
+        {
+            info = &generator;
+            break;
+        }
+    }
+
+    assert(info, string("Unknown truth table generator \"") + specification +
+        "\", valid values are:\n" + TruthTableGenerator::getUsage());
+
+    assert(parts.size() == info->argCount + 1,
+        string("Truth table generator \"") + specification + "\" has wrong number of arguments, " +
+        "expected " + info->name + ':' + info->arguments);
+
+    args->clear();
+    for (uint index = 1; index < parts.size(); ++index)
+    {
+        const string& part = parts[index];
+
+        bool isNumber = !part.empty() && part.size() < 10 &&
+            all_of(part.cbegin(), part.cend(), [](char symbol) { return isdigit(symbol) != 0; });
+
+        assert(isNumber, string("Truth table generator \"") + specification +
+            "\" has wrong argument \"" + part + "\"");
+
+        args->push_back((uint)stoul(part));
+    }
+
+    return *info;
+}
+
+template<typename Entry>
+BasicTruthTable<Entry> TruthTableGenerator::generate(const string& specification)
+{
+    vector<uint> args;
+    GeneratorFunc<Entry> func = parseSpecification(specification, &args).getFunc<Entry>();
+
+    func(args, 0, &inputCount, &outputCount);
+    assert(outputCount <= (uint)numeric_limits<Entry>::digits,
+        string("Truth table generator \"") + specification +
+        "\": output values don't fit in entry");
+
+    BasicTruthTable<Entry> table;
+    func(args, &table, &inputCount, &outputCount);
+
+    return table;
+}
+
+void TruthTableGenerator::parse(const string& specification)
+{
+    vector<uint> args;
+    parseSpecification(specification, &args).func64(args, 0, &inputCount, &outputCount);
+}
+
+uint TruthTableGenerator::getInputCount() const
+{
+    return inputCount;
+}
+
+uint TruthTableGenerator::getOutputCount() const
+{
+    return outputCount;
+}
+
+//static
+string TruthTableGenerator::getUsage()
+{
+    ostringstream stream;
+    for (auto& generator : generators)
+    {
+        stream << "    " << generator.name << ':' << generator.arguments << " - ";
+        stream << generator.description << '\n';
+    }
+
+    return stream.str();
+}
+
+// packed truth tables, word is one of these types
+template BasicTruthTable<uint16_t> TruthTableGenerator::generate(const string&);
+template BasicTruthTable<uint32_t> TruthTableGenerator::generate(const string&);
+template BasicTruthTable<uint64_t> TruthTableGenerator::generate(const string&);
+
+} //namespace ReversibleLogic
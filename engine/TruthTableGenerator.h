@@ -0,0 +1,55 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Procedural generator of benchmark truth tables: table is filled right in memory
+/// in parallel, so large functions don't need text files.
+/// Function is specified as "name:arg1[:arg2...]", e.g. "hwb:16" or "mod:5:5",
+/// list of functions is returned by getUsage().
+class TruthTableGenerator
+{
+public:
+    TruthTableGenerator() = default;
+    virtual ~TruthTableGenerator() = default;
+
+    /// Output values should fit in @Entry type
+    template<typename Entry>
+    BasicTruthTable<Entry> generate(const string& specification);
+
+    /// Only checks @specification and sets input and output counts, so entry type
+    /// of table could be chosen before generation
+    void parse(const string& specification);
+
+    uint getInputCount() const;
+    uint getOutputCount() const;
+
+    /// Returns specifications of all functions, one per line
+    static string getUsage();
+
+private:
+    uint inputCount = 0;
+    uint outputCount = 0;
+};
+
+} //namespace ReversibleLogic
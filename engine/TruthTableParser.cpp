@@ -23,15 +23,62 @@
 namespace ReversibleLogic
 {
 
-TruthTable TruthTableParser::parse(istream& input)
+template<typename Entry>
+BasicTruthTable<Entry> TruthTableParser::parse(istream& input)
 {
-    string firstLine;
-    getline(input, firstLine);
+    string text((istreambuf_iterator<char>(input)), istreambuf_iterator<char>());
+    return parseText<Entry>(text.data(), text.data() + text.size());
+}
+
+template<typename Entry>
+BasicTruthTable<Entry> TruthTableParser::parse(const string& fileName)
+{
+    MappedFile file;
+    assert(file.open(fileName),
+        string("Failed to open input file \"") + fileName + "\" for reading");
+
+    const char* begin = (const char*)file.getData();
+    return parseText<Entry>(begin, begin + file.getSize());
+}
 
-    int base = parseFirstLine(firstLine);
+void TruthTableParser::parseHeader(const string& fileName)
+{
+    MappedFile file;
+    assert(file.open(fileName),
+        string("Failed to open input file \"") + fileName + "\" for reading");
+
+    const char* begin = (const char*)file.getData();
+    int base = 0;
+    parseHeader(begin, begin + file.getSize(), &base);
+}
+
+const char* TruthTableParser::parseHeader(const char* begin, const char* end, int* base)
+{
+    const char* firstLineEnd = find(begin, end, '\n');
+
+    string firstLine(begin, firstLineEnd);
+    if (!firstLine.empty() && firstLine.back() == '\r')
+        firstLine.pop_back();
+
+    *base = parseFirstLine(firstLine);
     assert(inputCount >= outputCount, string("Case N < M is not implemented"));
 
-    return parseMainBody(input, base);
+    if (*base < 2 || *base > 36 || inputCount >= sizeof(word) * 8)
+        throw InvalidFormatException(string("Invalid first line of truth table: ") + firstLine);
+
+    return (firstLineEnd == end ? end : firstLineEnd + 1);
+}
+
+template<typename Entry>
+BasicTruthTable<Entry> TruthTableParser::parseText(const char* begin, const char* end)
+{
+    int base = 0;
+    const char* bodyBegin = parseHeader(begin, end, &base);
+
+    assert(outputCount <= (uint)numeric_limits<Entry>::digits,
+        string("TruthTableParser::parse(): output values don't fit in entry"));
+
+    return parseMainBody<Entry>(bodyBegin, end, base);
 }
 
 int TruthTableParser::parseFirstLine(const string& line)
@@ -54,62 +101,169 @@ int TruthTableParser::parseFirstLine(const string& line)
     return base;
 }
 
-TruthTable TruthTableParser::parseMainBody(istream& input, int base /*= 2*/)
+template<typename Entry>
+BasicTruthTable<Entry> TruthTableParser::parseMainBody(const char* begin, const char* end,
+    int base /*= 2*/)
 {
-    const char* strDelimiter = "\t=>\t";
-    const uint numDelimiterLength = strlen(strDelimiter);
+    // chunks are small enough to be balanced between threads
+    const uint64_t numMinChunkSize = 1 << 16;
 
-    TruthTable table;
-    table.resize(1 << inputCount);
+    word maxInputValue = (word)1 << inputCount;
+    word maxOutputValue = (word)1 << outputCount;
 
-    // fill table with 0xFF
-    memset(table.data(), 0xFF, sizeof(TruthTable::value_type)* table.size());
+    BasicTruthTable<Entry> table;
+    table.resize((size_t)maxInputValue);
 
-    uint count = 0;
-    string currentLine;
+    // bitmap of parsed inputs, shared by all chunks to detect duplicates
+    uint bitCount = sizeof(word) * 8;
+    vector<atomic<word>> parsedFlags((size_t)((maxInputValue + bitCount - 1) / bitCount));
+    for (auto& flags : parsedFlags)
+        flags.store(0, memory_order_relaxed);
 
-    int maxInputValue = 1 << inputCount;
-    int maxOutputValue = 1 << outputCount;
+    ThreadPool& pool = ThreadPool::get();
+    uint64_t size = (uint64_t)(end - begin);
 
-    try
+    uint chunkCount = pool.getThreadCount() * 4;
+    if (size / chunkCount < numMinChunkSize)
+        chunkCount = (uint)(size / numMinChunkSize) + 1;
+
+    // chunk borders are moved to the beginnings of lines
+    vector<const char*> borders(chunkCount + 1);
+    borders[0] = begin;
+    borders[chunkCount] = end;
+
+    for (uint index = 1; index < chunkCount; ++index)
     {
-        while (input.good())
-        {
-            string line;
-            getline(input, line);
+        const char* border = max(begin + size * index / chunkCount, borders[index - 1]);
+        border = find(border, end, '\n');
+        borders[index] = (border == end ? end : border + 1);
+    }
+
+    vector<word> lineCounts(chunkCount, 0);
+    vector<string> errors(chunkCount);
+
+    pool.parallelFor(chunkCount, [&](uint index)
+    {
+        lineCounts[index] = parseChunk(borders[index], borders[index + 1], base,
+            maxInputValue, maxOutputValue, &table, &parsedFlags, &errors[index]);
+    });
+
+    word count = 0;
+    for (uint index = 0; index < chunkCount; ++index)
+    {
+        if (!errors[index].empty())
+            throw InvalidFormatException(string("Invalid truth table line: ") + errors[index]);
+
+        count += lineCounts[index];
+    }
+
+    // there are no duplicates, so table is complete if all inputs are parsed
+    if (count != maxInputValue)
+        throw InvalidFormatException(string("Truth table is incomplete"));
 
-            if (line.empty())
-                continue;
+    return table;
+}
 
-            currentLine = line;
+//static
+template<typename Entry>
+word TruthTableParser::parseChunk(const char* begin, const char* end, int base,
+    word maxInputValue, word maxOutputValue, BasicTruthTable<Entry>* table,
+    vector<atomic<word>>* parsedFlags, string* error)
+{
+    const char* strDelimiter = "\t=>\t";
+    const uint numDelimiterLength = strlen(strDelimiter);
 
-            size_t pos = 0;
-            int x = stoi(line, &pos, base);
+    uint bitCount = sizeof(word) * 8;
+    word count = 0;
+
+    const char* position = begin;
+    while (position < end)
+    {
+        const char* lineBegin = position;
+        const char* lineEnd = find(position, end, '\n');
+        position = (lineEnd == end ? end : lineEnd + 1);
 
-            assertFormat(pos != 0 && pos != line.size() && x >= 0);
-            assertFormat(line.compare(pos, numDelimiterLength, strDelimiter) == 0);
+        if (lineEnd > lineBegin && *(lineEnd - 1) == '\r')
+            --lineEnd;
 
-            line = line.substr(pos + numDelimiterLength);
-            int y = stoi(line, &pos, base);
+        if (lineBegin == lineEnd)
+            continue;
 
-            assertFormat(pos == line.size() && y >= 0);
-            assertFormat(x < maxInputValue && y < maxOutputValue);
-            assertFormat(table[x] == wordUndefined);
+        const char* current = lineBegin;
+        word x = 0;
+        word y = 0;
 
-            table[x] = (word)y;
-            ++count;
+        bool valid = parseNumber(&current, lineEnd, base, maxInputValue, &x) &&
+            (uint)(lineEnd - current) > numDelimiterLength &&
+            memcmp(current, strDelimiter, numDelimiterLength) == 0;
+
+        if (valid)
+        {
+            current += numDelimiterLength;
+            valid = parseNumber(&current, lineEnd, base, maxOutputValue, &y) && current == lineEnd;
+        }
+
+        if (valid)
+        {
+            word flag = (word)1 << (x % bitCount);
+            word previous = (*parsedFlags)[(size_t)(x / bitCount)].fetch_or(flag, memory_order_relaxed);
+            valid = !(previous & flag);
+        }
+
+        if (!valid)
+        {
+            *error = string(lineBegin, lineEnd);
+            break;
         }
+
+        (*table)[(size_t)x] = (Entry)y;
+        ++count;
     }
-    catch (InvalidFormatException& ex)
+
+    return count;
+}
+
+//static
+bool TruthTableParser::parseNumber(const char** position, const char* end, int base,
+    word maxValue, word* value)
+{
+    // if number is not less than threshold, it would be not less than maxValue after next digit
+    word threshold = (maxValue + base - 1) / base;
+
+    const char* current = *position;
+    word result = 0;
+
+    for (; current < end; ++current)
     {
-        ex.setMessage(string("Invalid truth table line: ") + currentLine);
-        throw ex;
+        char symbol = *current;
+
+        uint digit = 0;
+        if (symbol >= '0' && symbol <= '9')
+            digit = symbol - '0';
+        else if (symbol >= 'a' && symbol <= 'z')
+            digit = symbol - 'a' + 10;
+        else if (symbol >= 'A' && symbol <= 'Z')
+            digit = symbol - 'A' + 10;
+        else
+            break;
+
+        if (digit >= (uint)base)
+            break;
+
+        if (result >= threshold)
+            return false;
+
+        result = result * base + digit;
+        if (result >= maxValue)
+            return false;
     }
 
-    if (count != maxInputValue)
-        throw InvalidFormatException(string("Truth table is incomplete"));
+    if (current == *position)
+        return false;
 
-    return table;
+    *position = current;
+    *value = result;
+    return true;
 }
 
 uint TruthTableParser::getInputCount() const
@@ -122,4 +276,15 @@ uint TruthTableParser::getOutputCount() const
     return outputCount;
 }
 
+// packed truth tables, word is one of these types
+#define INSTANTIATE_TRUTH_TABLE_PARSER(Entry) \
+    template BasicTruthTable<Entry> TruthTableParser::parse(istream&); \
+    template BasicTruthTable<Entry> TruthTableParser::parse(const string&);
+
+INSTANTIATE_TRUTH_TABLE_PARSER(uint16_t)
+INSTANTIATE_TRUTH_TABLE_PARSER(uint32_t)
+INSTANTIATE_TRUTH_TABLE_PARSER(uint64_t)
+
+#undef INSTANTIATE_TRUTH_TABLE_PARSER
+
 } //namespace ReversibleLogic
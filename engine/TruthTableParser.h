@@ -29,7 +29,17 @@ public:
     TruthTableParser() = default;
     virtual ~TruthTableParser() = default;
 
-    TruthTable parse(istream& input);
+    /// Output values should fit in @Entry type
+    template<typename Entry>
+    BasicTruthTable<Entry> parse(istream& input);
+
+    /// Same as parse(istream&), but file is memory mapped and its lines are parsed in parallel
+    template<typename Entry>
+    BasicTruthTable<Entry> parse(const string& fileName);
+
+    /// Parses only the first line of file, so entry type of table could be chosen
+    /// by input and output counts before parsing
+    void parseHeader(const string& fileName);
     
     uint getInputCount() const;
     uint getOutputCount() const;
@@ -38,7 +48,27 @@ private:
     /// Returns number's base in input
     int parseFirstLine(const string& line);
 
-    TruthTable parseMainBody(istream& input, int base = 2);
+    /// Parses the first line of text, returns beginning of main body
+    const char* parseHeader(const char* begin, const char* end, int* base);
+
+    template<typename Entry>
+    BasicTruthTable<Entry> parseText(const char* begin, const char* end);
+
+    /// Main body is split at line boundaries into chunks, which are parsed independently
+    template<typename Entry>
+    BasicTruthTable<Entry> parseMainBody(const char* begin, const char* end, int base = 2);
+
+    /// Parses lines from [begin, end) to @table, @parsedFlags is bitmap of parsed inputs
+    /// Returns number of parsed lines, @error is set to invalid line
+    template<typename Entry>
+    static word parseChunk(const char* begin, const char* end, int base, word maxInputValue,
+        word maxOutputValue, BasicTruthTable<Entry>* table, vector<atomic<word>>* parsedFlags,
+        string* error);
+
+    /// Parses number in @base from *@position, returns false if there are no digits
+    /// or number is not less than @maxValue
+    static bool parseNumber(const char** position, const char* end, int base, word maxValue,
+        word* value);
 
     uint inputCount = 0;
     uint outputCount = 0;
@@ -24,14 +24,15 @@ namespace ReversibleLogic
 {
 
 //static
-TruthTable TruthTableUtils::optimizeHammingDistance(const TruthTable& original, uint n, uint m,
-    unordered_map<uint, uint>* outputVariablesOrder /*= 0*/)
+template<typename Entry>
+BasicTruthTable<Entry> TruthTableUtils::optimizeHammingDistance(const BasicTruthTable<Entry>& original,
+    uint n, uint m, unordered_map<uint, uint>* outputVariablesOrder /*= 0*/)
 {
     assertd(original.size() == (size_t)(1 << n),
         string("TruthTableUtils::optimizeHammingDistance(): invalid table size"));
 
     uint k = calculateNewInputVariableCount(original, n, m);
-    TruthTable table = extendTruthTable(original, k, n);
+    BasicTruthTable<Entry> table = extendTruthTable(original, k, n);
 
     vector<SumVector> distances = calculateHammingDistances(table, k, n, m);
     sortSumVectorsForOutputVariables(&distances, n);
@@ -51,7 +52,9 @@ TruthTable TruthTableUtils::optimizeHammingDistance(const TruthTable& original,
 }
 
 //static
-uint TruthTableUtils::calculateNewInputVariableCount(const TruthTable& original, uint n, uint m)
+template<typename Entry>
+uint TruthTableUtils::calculateNewInputVariableCount(const BasicTruthTable<Entry>& original,
+    uint n, uint m)
 {
     vector<uint> frequency;
     frequency.resize(1 << m);
@@ -72,15 +75,17 @@ uint TruthTableUtils::calculateNewInputVariableCount(const TruthTable& original,
 }
 
 //static
-TruthTable TruthTableUtils::extendTruthTable(const TruthTable &original, uint k, uint n)
+template<typename Entry>
+BasicTruthTable<Entry> TruthTableUtils::extendTruthTable(const BasicTruthTable<Entry>& original,
+    uint k, uint n)
 {
-    TruthTable table;
+    BasicTruthTable<Entry> table;
     if (k == n)
         table = original;
     else
     {
         table.resize(1 << k);
-        memset(table.data(), 0, sizeof(TruthTable::value_type) * table.size());
+        memset(table.data(), 0, sizeof(Entry) * table.size());
 
         uint entryCount = original.size();
         for (uint index = 0; index < entryCount; ++index)
@@ -91,8 +96,9 @@ TruthTable TruthTableUtils::extendTruthTable(const TruthTable &original, uint k,
 }
 
 //static
+template<typename Entry>
 vector<TruthTableUtils::SumVector> TruthTableUtils::calculateHammingDistances(
-    const TruthTable& table, uint k, uint n, uint m)
+    const BasicTruthTable<Entry>& table, uint k, uint n, uint m)
 {
     vector<SumVector> distances;
     distances.resize(m);
@@ -251,16 +257,17 @@ unordered_map<uint, uint> TruthTableUtils::calculateNewOrderOfOutputVariables(
 }
 
 //static
-void TruthTableUtils::reorderOutputVariables(TruthTable* tablePtr,
+template<typename Entry>
+void TruthTableUtils::reorderOutputVariables(BasicTruthTable<Entry>* tablePtr,
     const unordered_map<uint, uint>& newOrderMap, uint n, uint m)
 {
-    TruthTable& table = *tablePtr;
+    BasicTruthTable<Entry>& table = *tablePtr;
     uint entryCount = (uint)1 << n;
 
     for (uint index = 0; index < entryCount; ++index)
     {
         word y = table[index];
-        table[index] = reorderBits(y, m, newOrderMap);
+        table[index] = (Entry)reorderBits(y, m, newOrderMap);
     }
 }
 
@@ -285,10 +292,11 @@ word TruthTableUtils::calculateOutputsMask(const unordered_map<uint, uint>& newO
 }
 
 //static
-void TruthTableUtils::pickUpBestOutputValues(TruthTable* tablePtr,
+template<typename Entry>
+void TruthTableUtils::pickUpBestOutputValues(BasicTruthTable<Entry>* tablePtr,
     uint n, uint k, word outputsMask)
 {
-    TruthTable& table = *tablePtr;
+    BasicTruthTable<Entry>& table = *tablePtr;
 
     word totalInputCount  = (word)1 << n;
     word totalOutputCount = (word)1 << k;
@@ -351,10 +359,11 @@ void TruthTableUtils::pickUpBestOutputValues(TruthTable* tablePtr,
 }
 
 //static
-void TruthTableUtils::pickUpBestOutputValues(TruthTable* tablePtr, unordered_set<word> inputs,
-    unordered_set<word> outputs)
+template<typename Entry>
+void TruthTableUtils::pickUpBestOutputValues(BasicTruthTable<Entry>* tablePtr,
+    unordered_set<word> inputs, unordered_set<word> outputs)
 {
-    TruthTable& table = *tablePtr;
+    BasicTruthTable<Entry>& table = *tablePtr;
 
     // tuning option
     const ProgramOptions& options = ProgramOptions::get();
@@ -377,7 +386,7 @@ void TruthTableUtils::pickUpBestOutputValues(TruthTable* tablePtr, unordered_set
             word input  = *inputs.cbegin();
             word output = *outputs.cbegin();
 
-            table[input] = output;
+            table[input] = (Entry)output;
             break;
         }
 
@@ -437,7 +446,7 @@ void TruthTableUtils::pickUpBestOutputValues(TruthTable* tablePtr, unordered_set
         }
 
         // assign output for best input
-        table[bestInput] = bestOutput;
+        table[bestInput] = (Entry)bestOutput;
 
         // clear map
         for (auto iter : inputToBestIndexMap)
@@ -507,12 +516,13 @@ void TruthTableUtils::updateBestIndicesForInput(InputToBestIndexMap* mapPtr,
 }
 
 //static
-void TruthTableUtils::makePermutationEvenIfNecessary(TruthTable* tablePtr, uint k, uint n)
+template<typename Entry>
+void TruthTableUtils::makePermutationEvenIfNecessary(BasicTruthTable<Entry>* tablePtr, uint k, uint n)
 {
     const ProgramOptions& options = ProgramOptions::get();
     if (k > n && options.isTuningEnabled && options.options.getBool("complete-permutation-to-even", false))
     {
-        TruthTable& table = *tablePtr;
+        BasicTruthTable<Entry>& table = *tablePtr;
 
         Permutation permutation = PermutationUtils::createPermutation(table, false);
         if (!permutation.isEven())
@@ -548,8 +558,9 @@ void TruthTableUtils::makePermutationEvenIfNecessary(TruthTable* tablePtr, uint
 }
 
 //static
-int TruthTableUtils::calculateHammingDistanceChangeForTwoEntriesSwap(const TruthTable& table,
-    uint firstIndex, uint lastIndex)
+template<typename Entry>
+int TruthTableUtils::calculateHammingDistanceChangeForTwoEntriesSwap(
+    const BasicTruthTable<Entry>& table, uint firstIndex, uint lastIndex)
 {
     int beforeSum =
         (int)countNonZeroBits(firstIndex ^ table[firstIndex]) +
@@ -563,7 +574,9 @@ int TruthTableUtils::calculateHammingDistanceChangeForTwoEntriesSwap(const Truth
 }
 
 //static
-bool TruthTableUtils::checkSchemeAgainstPermutationVector(const Scheme& scheme, const TruthTable& table)
+template<typename Entry>
+bool TruthTableUtils::checkSchemeAgainstPermutationVector(const Scheme& scheme,
+    const BasicTruthTable<Entry>& table)
 {
     bool result = true;
     uint size = table.size();
@@ -584,4 +597,52 @@ bool TruthTableUtils::checkSchemeAgainstPermutationVector(const Scheme& scheme,
     return result;
 }
 
+//static
+uint TruthTableUtils::getPackedEntrySize(uint n)
+{
+    uint size = sizeof(uint64_t);
+    if (n < numeric_limits<uint16_t>::digits)
+        size = sizeof(uint16_t);
+    else if (n < numeric_limits<uint32_t>::digits)
+        size = sizeof(uint32_t);
+
+    return size;
+}
+
+//static
+template<typename Entry, typename SourceEntry>
+BasicTruthTable<Entry> TruthTableUtils::packTruthTable(const BasicTruthTable<SourceEntry>& table)
+{
+    size_t size = table.size();
+    BasicTruthTable<Entry> packedTable(size);
+
+    for (size_t index = 0; index < size; ++index)
+    {
+        SourceEntry value = table[index];
+        assert(value < numeric_limits<Entry>::max(),
+            string("TruthTableUtils::packTruthTable(): value doesn't fit in entry"));
+
+        packedTable[index] = (Entry)value;
+    }
+
+    return packedTable;
+}
+
+// packed truth tables, word is one of these types
+#define INSTANTIATE_TRUTH_TABLE_UTILS(Entry) \
+    template BasicTruthTable<Entry> TruthTableUtils::optimizeHammingDistance( \
+        const BasicTruthTable<Entry>&, uint, uint, unordered_map<uint, uint>*); \
+    template bool TruthTableUtils::checkSchemeAgainstPermutationVector( \
+        const Scheme&, const BasicTruthTable<Entry>&); \
+    template BasicTruthTable<uint16_t> TruthTableUtils::packTruthTable( \
+        const BasicTruthTable<Entry>&); \
+    template BasicTruthTable<uint32_t> TruthTableUtils::packTruthTable( \
+        const BasicTruthTable<Entry>&);
+
+INSTANTIATE_TRUTH_TABLE_UTILS(uint16_t)
+INSTANTIATE_TRUTH_TABLE_UTILS(uint32_t)
+INSTANTIATE_TRUTH_TABLE_UTILS(uint64_t)
+
+#undef INSTANTIATE_TRUTH_TABLE_UTILS
+
 } //namespace ReversibleLogic
@@ -26,18 +26,31 @@ namespace ReversibleLogic
 class TruthTableUtils
 {
 public:
-    static TruthTable optimizeHammingDistance(const TruthTable& original, uint n, uint m,
-        unordered_map<uint, uint>* outputVariablesOrder = 0);
+    template<typename Entry>
+    static BasicTruthTable<Entry> optimizeHammingDistance(const BasicTruthTable<Entry>& original,
+        uint n, uint m, unordered_map<uint, uint>* outputVariablesOrder = 0);
 
+    template<typename Entry>
     static bool checkSchemeAgainstPermutationVector(const Scheme& scheme,
-        const TruthTable& table);
+        const BasicTruthTable<Entry>& table);
+
+    /// Returns size in bytes of the narrowest entry type (uint16_t, uint32_t or uint64_t)
+    /// for permutation on @n variables, maximal value of type is never used by permutation
+    static uint getPackedEntrySize(uint n);
+
+    /// Returns copy of @table with entries of narrower @Entry type,
+    /// all values should be less than maximal value of it
+    template<typename Entry, typename SourceEntry>
+    static BasicTruthTable<Entry> packTruthTable(const BasicTruthTable<SourceEntry>& table);
 
 private:
     /// Returns minimal number of input variables to make permutation from @original truth table
-    static uint calculateNewInputVariableCount(const TruthTable& original, uint n, uint m);
+    template<typename Entry>
+    static uint calculateNewInputVariableCount(const BasicTruthTable<Entry>& original, uint n, uint m);
 
     /// Returns new truth table with beginning part equals to the @original one
-    static TruthTable extendTruthTable(const TruthTable &original, uint k, uint n);
+    template<typename Entry>
+    static BasicTruthTable<Entry> extendTruthTable(const BasicTruthTable<Entry>& original, uint k, uint n);
 
     struct DistanceSum
     {
@@ -50,7 +63,9 @@ private:
     typedef vector<DistanceSum> SumVector;
 
     /// Calculates Hamming distance for every output function with every input variable
-    static vector<SumVector> calculateHammingDistances(const TruthTable& table, uint k, uint n, uint m);
+    template<typename Entry>
+    static vector<SumVector> calculateHammingDistances(const BasicTruthTable<Entry>& table,
+        uint k, uint n, uint m);
 
     /// Sorts distances sum
     static void sortSumVectorsForOutputVariables(vector<SumVector>* distances, uint n);
@@ -60,8 +75,9 @@ private:
         vector<SumVector>* distancesPtr, uint m);
 
     /// Reorders output variables in @table according to @newOrderMap
-    static void reorderOutputVariables(TruthTable* tablePtr, const unordered_map<uint, uint>& newOrderMap,
-        uint n, uint m);
+    template<typename Entry>
+    static void reorderOutputVariables(BasicTruthTable<Entry>* tablePtr,
+        const unordered_map<uint, uint>& newOrderMap, uint n, uint m);
 
     static word reorderBits(word x, uint bitCount, const unordered_map<uint, uint>& reorderMap);
 
@@ -69,10 +85,12 @@ private:
     static word calculateOutputsMask(const unordered_map<uint, uint>& newOutputVariablesOrder);
 
     /// Picks the best outputs for @table inputs based on minimal Hamming distance
-    static void pickUpBestOutputValues(TruthTable* tablePtr,
+    template<typename Entry>
+    static void pickUpBestOutputValues(BasicTruthTable<Entry>* tablePtr,
         uint n, uint k, word outputsMask);
 
-    static void pickUpBestOutputValues(TruthTable* tablePtr, unordered_set<word> inputs,
+    template<typename Entry>
+    static void pickUpBestOutputValues(BasicTruthTable<Entry>* tablePtr, unordered_set<word> inputs,
         unordered_set<word> outputs);
 
     typedef unordered_map<word, deque<DistanceSum>> InputToBestIndexMap;
@@ -81,9 +99,11 @@ private:
     static void updateBestIndicesForInput(InputToBestIndexMap* mapPtr, const unordered_set<word>& inputs,
         const unordered_set<word>& outputs);
 
-    static void makePermutationEvenIfNecessary(TruthTable* table, uint k, uint n);
+    template<typename Entry>
+    static void makePermutationEvenIfNecessary(BasicTruthTable<Entry>* table, uint k, uint n);
 
-    static int calculateHammingDistanceChangeForTwoEntriesSwap(const TruthTable& table,
+    template<typename Entry>
+    static int calculateHammingDistanceChangeForTwoEntriesSwap(const BasicTruthTable<Entry>& table,
         uint firstIndex, uint lastIndex);
 };
 
@@ -0,0 +1,139 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "std.h"
+
+namespace ReversibleLogic
+{
+
+DynamicWord::DynamicWord(uint bitCount /* = 0 */)
+    : words((bitCount + numBitsInWord - 1) / numBitsInWord, 0)
+{
+}
+
+uint DynamicWord::getWordCount() const
+{
+    return words.size();
+}
+
+word DynamicWord::getWord(uint index) const
+{
+    return (index < words.size() ? words[index] : 0);
+}
+
+void DynamicWord::setWord(uint index, word value)
+{
+    assertd(index < words.size(), string("DynamicWord::setWord(): invalid index"));
+    words[index] = value;
+}
+
+void DynamicWord::setLowBits(uint bitCount)
+{
+    assertd(bitCount <= words.size() * numBitsInWord, string("DynamicWord::setLowBits(): too many bits"));
+
+    for (auto& part : words)
+    {
+        if (!bitCount)
+            break;
+
+        uint count = (bitCount < numBitsInWord ? bitCount : numBitsInWord);
+        part |= BitVectorTraits<word>::createMask(count);
+
+        bitCount -= count;
+    }
+}
+
+uint DynamicWord::countNonZeroBits() const
+{
+    uint count = 0;
+    for (auto part : words)
+        count += ::countNonZeroBits(part);
+
+    return count;
+}
+
+size_t DynamicWord::getHash() const
+{
+    size_t result = 0;
+    for (auto part : words)
+        result ^= hash<word>()(part) + 0x9e3779b9 + (result << 6) + (result >> 2);
+
+    return result;
+}
+
+DynamicWord DynamicWord::operator~() const
+{
+    DynamicWord result(*this);
+    for (auto& part : result.words)
+        part = ~part;
+
+    return result;
+}
+
+DynamicWord DynamicWord::operator&(const DynamicWord& another) const
+{
+    assertd(words.size() == another.words.size(), string("DynamicWord::operator&(): size mismatch"));
+
+    DynamicWord result(*this);
+    uint count = words.size();
+
+    for (uint index = 0; index < count; ++index)
+        result.words[index] &= another.words[index];
+
+    return result;
+}
+
+DynamicWord DynamicWord::operator|(const DynamicWord& another) const
+{
+    assertd(words.size() == another.words.size(), string("DynamicWord::operator|(): size mismatch"));
+
+    DynamicWord result(*this);
+    uint count = words.size();
+
+    for (uint index = 0; index < count; ++index)
+        result.words[index] |= another.words[index];
+
+    return result;
+}
+
+DynamicWord DynamicWord::operator^(const DynamicWord& another) const
+{
+    assertd(words.size() == another.words.size(), string("DynamicWord::operator^(): size mismatch"));
+
+    DynamicWord result(*this);
+    uint count = words.size();
+
+    for (uint index = 0; index < count; ++index)
+        result.words[index] ^= another.words[index];
+
+    return result;
+}
+
+bool DynamicWord::operator==(const DynamicWord& another) const
+{
+    return words == another.words;
+}
+
+bool DynamicWord::operator!=(const DynamicWord& another) const
+{
+    return words != another.words;
+}
+
+} //namespace ReversibleLogic
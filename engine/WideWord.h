@@ -0,0 +1,315 @@
+// ReversibleLogicGenerator - generator of reversible logic circuits, based on permutation group theory.
+// Copyright (C) 2015  <Dmitry Zakablukov>
+// E-mail: dmitriy.zakablukov@gmail.com
+// Web: https://github.com/dmitry-zakablukov/ReversibleLogicGenerator
+// 
+// This file is part of ReversibleLogicGenerator.
+// 
+// ReversibleLogicGenerator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// ReversibleLogicGenerator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with ReversibleLogicGenerator.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace ReversibleLogic
+{
+
+/// Number of bits in one machine word
+const uint numBitsInWord = sizeof(word) * 8;
+
+/// Bit vector of fixed size, which consists of @WordCount machine words
+/// Word with index 0 contains least significant bits
+template<uint WordCount>
+class WideWord
+{
+public:
+    explicit WideWord(uint bitCount = 0);
+    ~WideWord() = default;
+
+    uint getWordCount() const;
+
+    word getWord(uint index) const;
+    void setWord(uint index, word value);
+
+    /// Sets @bitCount least significant bits
+    void setLowBits(uint bitCount);
+
+    uint countNonZeroBits() const;
+    size_t getHash() const;
+
+    WideWord operator~() const;
+    WideWord operator&(const WideWord& another) const;
+    WideWord operator|(const WideWord& another) const;
+    WideWord operator^(const WideWord& another) const;
+
+    bool operator==(const WideWord& another) const;
+    bool operator!=(const WideWord& another) const;
+
+private:
+    word words[WordCount];
+};
+
+/// Bit vector with size defined at run-time
+/// All vectors participating in one expression should have the same size
+class DynamicWord
+{
+public:
+    explicit DynamicWord(uint bitCount = 0);
+    ~DynamicWord() = default;
+
+    uint getWordCount() const;
+
+    word getWord(uint index) const;
+    void setWord(uint index, word value);
+
+    /// Sets @bitCount least significant bits
+    void setLowBits(uint bitCount);
+
+    uint countNonZeroBits() const;
+    size_t getHash() const;
+
+    DynamicWord operator~() const;
+    DynamicWord operator&(const DynamicWord& another) const;
+    DynamicWord operator|(const DynamicWord& another) const;
+    DynamicWord operator^(const DynamicWord& another) const;
+
+    bool operator==(const DynamicWord& another) const;
+    bool operator!=(const DynamicWord& another) const;
+
+private:
+    vector<word> words;
+};
+
+/// Uniform access to bit vectors of different types (word, WideWord, DynamicWord)
+template<typename T>
+struct BitVectorTraits
+{
+    /// Returns zero vector, which can hold @bitCount bits
+    static T create(uint bitCount)
+    {
+        return T(bitCount);
+    }
+
+    /// Returns vector with @bitCount least significant bits set
+    static T createMask(uint bitCount)
+    {
+        T mask(bitCount);
+        mask.setLowBits(bitCount);
+
+        return mask;
+    }
+
+    static uint getWordCount(const T& value)
+    {
+        return value.getWordCount();
+    }
+
+    static word getWord(const T& value, uint index)
+    {
+        return value.getWord(index);
+    }
+
+    static void setWord(T* value, uint index, word part)
+    {
+        value->setWord(index, part);
+    }
+
+    static uint countNonZeroBits(const T& value)
+    {
+        return value.countNonZeroBits();
+    }
+};
+
+template<>
+struct BitVectorTraits<word>
+{
+    static word create(uint /* bitCount */)
+    {
+        return 0;
+    }
+
+    static word createMask(uint bitCount)
+    {
+        assertd(bitCount <= numBitsInWord, string("BitVectorTraits::createMask(): too many bits"));
+
+        if (bitCount == numBitsInWord)
+            return wordUndefined;
+
+        return ((word)1 << bitCount) - 1;
+    }
+
+    static uint getWordCount(const word& /* value */)
+    {
+        return 1;
+    }
+
+    static word getWord(const word& value, uint index)
+    {
+        return (index ? 0 : value);
+    }
+
+    static void setWord(word* value, uint index, word part)
+    {
+        (void)index;
+        assertd(index == 0, string("BitVectorTraits::setWord(): invalid index"));
+
+        *value = part;
+    }
+
+    static uint countNonZeroBits(const word& value)
+    {
+        return ::countNonZeroBits(value);
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// WideWord implementation
+
+template<uint WordCount>
+WideWord<WordCount>::WideWord(uint bitCount /* = 0 */)
+{
+    // bit count is checked in debug build only
+    (void)bitCount;
+    assertd(bitCount <= WordCount * numBitsInWord, string("WideWord(): too many bits"));
+
+    memset(words, 0, sizeof(words));
+}
+
+template<uint WordCount>
+uint WideWord<WordCount>::getWordCount() const
+{
+    return WordCount;
+}
+
+template<uint WordCount>
+word WideWord<WordCount>::getWord(uint index) const
+{
+    return (index < WordCount ? words[index] : 0);
+}
+
+template<uint WordCount>
+void WideWord<WordCount>::setWord(uint index, word value)
+{
+    assertd(index < WordCount, string("WideWord::setWord(): invalid index"));
+    words[index] = value;
+}
+
+template<uint WordCount>
+void WideWord<WordCount>::setLowBits(uint bitCount)
+{
+    assertd(bitCount <= WordCount * numBitsInWord, string("WideWord::setLowBits(): too many bits"));
+
+    for (uint index = 0; index < WordCount && bitCount; ++index)
+    {
+        uint count = (bitCount < numBitsInWord ? bitCount : numBitsInWord);
+        words[index] |= BitVectorTraits<word>::createMask(count);
+
+        bitCount -= count;
+    }
+}
+
+template<uint WordCount>
+uint WideWord<WordCount>::countNonZeroBits() const
+{
+    uint count = 0;
+    for (uint index = 0; index < WordCount; ++index)
+        count += ::countNonZeroBits(words[index]);
+
+    return count;
+}
+
+template<uint WordCount>
+size_t WideWord<WordCount>::getHash() const
+{
+    size_t result = 0;
+    for (uint index = 0; index < WordCount; ++index)
+        result ^= hash<word>()(words[index]) + 0x9e3779b9 + (result << 6) + (result >> 2);
+
+    return result;
+}
+
+template<uint WordCount>
+WideWord<WordCount> WideWord<WordCount>::operator~() const
+{
+    WideWord result;
+    for (uint index = 0; index < WordCount; ++index)
+        result.words[index] = ~words[index];
+
+    return result;
+}
+
+template<uint WordCount>
+WideWord<WordCount> WideWord<WordCount>::operator&(const WideWord& another) const
+{
+    WideWord result;
+    for (uint index = 0; index < WordCount; ++index)
+        result.words[index] = words[index] & another.words[index];
+
+    return result;
+}
+
+template<uint WordCount>
+WideWord<WordCount> WideWord<WordCount>::operator|(const WideWord& another) const
+{
+    WideWord result;
+    for (uint index = 0; index < WordCount; ++index)
+        result.words[index] = words[index] | another.words[index];
+
+    return result;
+}
+
+template<uint WordCount>
+WideWord<WordCount> WideWord<WordCount>::operator^(const WideWord& another) const
+{
+    WideWord result;
+    for (uint index = 0; index < WordCount; ++index)
+        result.words[index] = words[index] ^ another.words[index];
+
+    return result;
+}
+
+template<uint WordCount>
+bool WideWord<WordCount>::operator==(const WideWord& another) const
+{
+    return memcmp(words, another.words, sizeof(words)) == 0;
+}
+
+template<uint WordCount>
+bool WideWord<WordCount>::operator!=(const WideWord& another) const
+{
+    return !(*this == another);
+}
+
+} //namespace ReversibleLogic
+
+namespace std
+{
+
+template<uint WordCount>
+struct hash<ReversibleLogic::WideWord<WordCount>>
+{
+    size_t operator()(const ReversibleLogic::WideWord<WordCount>& value) const
+    {
+        return value.getHash();
+    }
+};
+
+template<>
+struct hash<ReversibleLogic::DynamicWord>
+{
+    size_t operator()(const ReversibleLogic::DynamicWord& value) const
+    {
+        return value.getHash();
+    }
+};
+
+} //namespace std
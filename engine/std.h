@@ -23,6 +23,7 @@
 // system headers
 #include <string.h>
 #include <stdarg.h>
+#include <stdio.h>
 #include <exception>
 #include <iostream>
 #include <iomanip>
@@ -30,6 +31,7 @@
 #include <list>
 #include <deque>
 #include <vector>
+#include <array>
 #include <tuple>
 #include <set>
 #include <unordered_set>
@@ -38,7 +40,14 @@
 #include <functional>
 #include <algorithm>
 #include <memory>
+#include <cstdint>
 #include <ctime>
+#include <cmath>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <fstream>
 
 #if defined(__GNUC__)
@@ -46,6 +55,8 @@
 #   include <sys/stat.h>
 #   include <sys/types.h>
 #   include <unistd.h>
+#   include <fcntl.h>
+#   include <sys/mman.h>
 
 #   define _access access
 #   define _mkdir(name) mkdir((name), 0777)
@@ -89,17 +100,34 @@ using namespace std;
 
 #include "Exceptions.h"
 #include "utils.h"
+#include "WideWord.h"
+#include "BitMatrixUtils.h"
+#include "ThreadPool.h"
+#include "MappedFile.h"
 #include "Element.h"
+#include "GateSink.h"
+#include "BitSlicedSimulator.h"
 #include "SchemeUtils.h"
+#include "CommutationDag.h"
+#include "TemplateLibrary.h"
+#include "OptimalSynthesisTable.h"
 #include "Transposition.h"
+#include "TranspositionArena.h"
 #include "Cycle.h"
 #include "Permutation.h"
 #include "PermutationUtils.h"
 #include "PostProcessor.h"
+#include "LineNameTable.h"
+#include "SchemeWriter.h"
 #include "TfcFormatter.h"
+#include "RealFormatter.h"
+#include "BinaryScheme.h"
 #include "TruthTableParser.h"
+#include "TruthTableGenerator.h"
+#include "BinaryTruthTable.h"
 #include "TruthTableUtils.h"
 #include "BooleanEdgeSearcher.h"
+#include "PlaParser.h"
 #include "PartialResultParams.h"
 #include "PartialGtGenerator.h"
 #include "GtGenerator.h"
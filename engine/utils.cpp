@@ -66,6 +66,11 @@ uint getSignificantBitCount(word value)
     return count;
 }
 
+word getFullMask(uint n)
+{
+    return (n < sizeof(word) * 8 ? ((word)1 << n) - 1 : (word)-1);
+}
+
 bool isWhiteSpacesOnly(const string& line)
 {
     auto iter = line.cbegin();
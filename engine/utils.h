@@ -20,7 +20,12 @@
 
 #pragma once
 
-typedef vector<word> TruthTable;
+/// Truth table with entries of unsigned integer type @Entry, values of function on
+/// n variables could be kept in type, which is narrower than word
+template<typename Entry>
+using BasicTruthTable = vector<Entry>;
+
+typedef BasicTruthTable<word> TruthTable;
 
 // debug assert
 #if defined(DEBUG) || defined(_DEBUG)
@@ -47,6 +52,9 @@ uint countNonZeroBits(word value);
 uint findPositiveBitPosition(word value, uint startPos = 0);
 uint getSignificantBitCount(word value);
 
+/// Returns mask of @n low bits, @n could be up to 64
+word getFullMask(uint n);
+
 template< typename T >
 deque<T> conjugate(deque<T> target, deque<T> conjugations, bool withReverse = false)
 {
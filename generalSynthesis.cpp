@@ -20,29 +20,9 @@
 
 #include "std.h"
 
-TruthTable getHwb(uint n)
-{
-    word count = 1 << n;
-    word mask = count - 1;
-    
-    TruthTable table;
-    table.resize(count);
-
-    for (word x = 0; x < count; ++x)
-    {
-        uint weight = countNonZeroBits(x);
-
-        word y = ((x << weight) & mask) |
-            ((x >> (n - weight)) & mask);
-
-        table[x] = y;
-    }
-
-    return table;
-}
-
-void synthesizeScheme(const TruthTable& table, ostream& resultsOutput, const string& tfcOutputFileName,
-    ReversibleLogic::TfcFormatter* formatter)
+template<typename Entry>
+void synthesizeScheme(const BasicTruthTable<Entry>& table, ostream& resultsOutput,
+    const string& tfcOutputFileName, ReversibleLogic::TfcFormatter* formatter)
 {
     using namespace ReversibleLogic;
 
@@ -50,17 +30,16 @@ void synthesizeScheme(const TruthTable& table, ostream& resultsOutput, const str
 
     try
     {
+        uint n = (uint)(log(table.size()) / log(2));
+        n = max(n, formatter->getVariablesCount());
+
         CompositeGenerator generator;
-        Scheme scheme = generator.generate(table, resultsOutput);
-        
-        ofstream tfcOutput(tfcOutputFileName);
-        assert(tfcOutput.is_open(),
-            string("Failed to open tfc file \"") + tfcOutputFileName + "\" for writing");
+        writeSchemeFile(n, formatter, tfcOutputFileName, [&](GateSink* sink)
+        {
+            generator.generate(table, sink, resultsOutput);
+        });
 
         resultsOutput << "Scheme file: " << tfcOutputFileName << endl;
-
-        formatter->format(tfcOutput, scheme);
-        tfcOutput.close();
     }
     catch (exception& ex)
     {
@@ -80,6 +59,84 @@ void synthesizeScheme(const TruthTable& table, ostream& resultsOutput, const str
     synthesizeScheme(table, resultsOutput, tfcOutputFileName, &formatter);
 }
 
+template<typename Entry>
+void synthesizeTruthTable(BasicTruthTable<Entry>* table, uint inputCount, uint outputCount,
+    const string& schemeName, ostream& resultsOutput, const string& schemesFolder)
+{
+    using namespace ReversibleLogic;
+
+    assertd(table, string("synthesizeTruthTable(): null ptr"));
+
+    const ProgramOptions& options = ProgramOptions::get();
+
+    unordered_map<uint, uint> outputVariablesOrder;
+    if (inputCount == outputCount)
+    {
+        for (uint index = 0; index < inputCount; ++index)
+            outputVariablesOrder[index] = index;
+    }
+
+    if (inputCount != outputCount || !options.isTuningEnabled ||
+        !options.options.getBool("do-not-alter-output-variables-order", false))
+    {
+        *table = TruthTableUtils::optimizeHammingDistance(*table,
+            inputCount, outputCount, &outputVariablesOrder);
+    }
+
+    string tfcOutputFileName = appendPath(schemesFolder,
+        schemeName + "-out" + getSchemeFileExtension());
+
+    TfcFormatter formatter(inputCount, outputCount, outputVariablesOrder);
+    synthesizeScheme(*table, resultsOutput, tfcOutputFileName, &formatter);
+}
+
+/// Returns entry size of loaded table, which fits values of table extended
+/// by ancillary inputs (see TruthTableUtils::optimizeHammingDistance())
+uint getLoadedEntrySize(uint inputCount, uint outputCount)
+{
+    using namespace ReversibleLogic;
+
+    uint n = inputCount;
+    if (inputCount != outputCount)
+        n = inputCount + outputCount;
+
+    return TruthTableUtils::getPackedEntrySize(n);
+}
+
+template<typename Entry>
+void synthesizeBinaryTruthTable(const ReversibleLogic::BinaryTruthTable& binaryTable,
+    const string& schemeName, ostream& resultsOutput, const string& schemesFolder)
+{
+    // entries of permutation with 9..15 or 17..31 variables have the width of Entry,
+    // so they are copied from mapped file without decoding and widening
+    BasicTruthTable<Entry> table = binaryTable.toTruthTable<Entry>();
+    synthesizeTruthTable(&table, binaryTable.getInputCount(), binaryTable.getOutputCount(),
+        schemeName, resultsOutput, schemesFolder);
+}
+
+template<typename Entry>
+void synthesizeTextTruthTable(ReversibleLogic::TruthTableParser* parser, const string& fileName,
+    ostream& resultsOutput, const string& schemesFolder)
+{
+    BasicTruthTable<Entry> table = parser->parse<Entry>(fileName);
+    synthesizeTruthTable(&table, parser->getInputCount(), parser->getOutputCount(),
+        getFileName(fileName), resultsOutput, schemesFolder);
+}
+
+template<typename Entry>
+void synthesizeGeneratedTruthTable(ReversibleLogic::TruthTableGenerator* generator,
+    const string& specification, ostream& resultsOutput, const string& schemesFolder)
+{
+    BasicTruthTable<Entry> table = generator->generate<Entry>(specification);
+
+    // ':' is not allowed in file names
+    string schemeName = specification;
+    replace(schemeName.begin(), schemeName.end(), ':', '_');
+
+    synthesizeTruthTable(&table, generator->getInputCount(), generator->getOutputCount(),
+        schemeName, resultsOutput, schemesFolder);
+}
+
 void processTruthTables(ostream& resultsOutput, const string& schemesFolder)
 {
     using namespace ReversibleLogic;
@@ -94,43 +151,163 @@ void processTruthTables(ostream& resultsOutput, const string& schemesFolder)
         {
             try
             {
-                ifstream inputFile(truthTableInputFileName);
-                assert(inputFile.is_open(),
-                    string("Failed to open input file \"") + truthTableInputFileName + "\" for reading");
-
                 resultsOutput << "Truth table: " << truthTableInputFileName << endl;
 
-                TruthTableParser parser;
-                TruthTable table = parser.parse(inputFile);
-
-                uint inputCount  = parser.getInputCount();
-                uint outputCount = parser.getOutputCount();
-
-                unordered_map<uint, uint> outputVariablesOrder;
-                if (inputCount == outputCount)
+                // table is loaded right to entries of the narrowest type
+                if (BinaryTruthTable::isBinaryTruthTableFile(truthTableInputFileName))
                 {
-                    for (uint index = 0; index < inputCount; ++index)
-                        outputVariablesOrder[index] = index;
+                    BinaryTruthTable binaryTable;
+                    binaryTable.load(truthTableInputFileName);
+
+                    string schemeName = getFileName(truthTableInputFileName);
+                    switch (getLoadedEntrySize(binaryTable.getInputCount(),
+                        binaryTable.getOutputCount()))
+                    {
+                    case sizeof(uint16_t):
+                        synthesizeBinaryTruthTable<uint16_t>(binaryTable, schemeName,
+                            resultsOutput, schemesFolder);
+                        break;
+
+                    case sizeof(uint32_t):
+                        synthesizeBinaryTruthTable<uint32_t>(binaryTable, schemeName,
+                            resultsOutput, schemesFolder);
+                        break;
+
+                    default:
+                        synthesizeBinaryTruthTable<uint64_t>(binaryTable, schemeName,
+                            resultsOutput, schemesFolder);
+                        break;
+                    }
                 }
+                else
+                {
+                    TruthTableParser parser;
+                    parser.parseHeader(truthTableInputFileName);
+
+                    switch (getLoadedEntrySize(parser.getInputCount(), parser.getOutputCount()))
+                    {
+                    case sizeof(uint16_t):
+                        synthesizeTextTruthTable<uint16_t>(&parser, truthTableInputFileName,
+                            resultsOutput, schemesFolder);
+                        break;
+
+                    case sizeof(uint32_t):
+                        synthesizeTextTruthTable<uint32_t>(&parser, truthTableInputFileName,
+                            resultsOutput, schemesFolder);
+                        break;
+
+                    default:
+                        synthesizeTextTruthTable<uint64_t>(&parser, truthTableInputFileName,
+                            resultsOutput, schemesFolder);
+                        break;
+                    }
+                }
+            }
+            catch (exception& ex)
+            {
+                resultsOutput << ex.what() << endl;
+                resultsOutput << "\n===============================================================" << endl;
+            }
+        }
+    }
+}
+
+void processTruthTableGenerators(ostream& resultsOutput, const string& schemesFolder)
+{
+    using namespace ReversibleLogic;
+
+    const char* strTruthTableGenerator = "truth-table-generator";
 
-                if (inputCount != outputCount || !options.isTuningEnabled ||
-                    !options.options.getBool("do-not-alter-output-variables-order", false))
+    const ProgramOptions& options = ProgramOptions::get();
+    if (options.options.has(strTruthTableGenerator))
+    {
+        auto specifications = options.options[strTruthTableGenerator];
+        for (auto& specification : specifications)
+        {
+            try
+            {
+                resultsOutput << "Truth table generator: " << specification << endl;
+
+                TruthTableGenerator generator;
+                generator.parse(specification);
+
+                switch (getLoadedEntrySize(generator.getInputCount(), generator.getOutputCount()))
                 {
-                    table = TruthTableUtils::optimizeHammingDistance(table,
-                        inputCount, outputCount, &outputVariablesOrder);
+                case sizeof(uint16_t):
+                    synthesizeGeneratedTruthTable<uint16_t>(&generator, specification,
+                        resultsOutput, schemesFolder);
+                    break;
+
+                case sizeof(uint32_t):
+                    synthesizeGeneratedTruthTable<uint32_t>(&generator, specification,
+                        resultsOutput, schemesFolder);
+                    break;
+
+                default:
+                    synthesizeGeneratedTruthTable<uint64_t>(&generator, specification,
+                        resultsOutput, schemesFolder);
+                    break;
                 }
+            }
+            catch (exception& ex)
+            {
+                resultsOutput << ex.what() << endl;
+                resultsOutput << "\n===============================================================" << endl;
+            }
+        }
+    }
+}
+
+void processPlaFiles(ostream& resultsOutput, const string& schemesFolder)
+{
+    using namespace ReversibleLogic;
+
+    const char* strPlaInput = "pla-input";
+
+    const ProgramOptions& options = ProgramOptions::get();
+    if (options.options.has(strPlaInput))
+    {
+        auto plaInputFiles = options.options[strPlaInput];
+        for (auto& plaInputFileName : plaInputFiles)
+        {
+            try
+            {
+                resultsOutput << "PLA file: " << plaInputFileName << endl;
+
+                PlaParser parser;
+                parser.parse(plaInputFileName);
+
+                uint n = parser.getInputCount();
+                uint m = parser.getOutputCount();
+                resultsOutput << "Cube count: " << parser.getCubes().size() << endl;
 
                 string tfcOutputFileName = appendPath(schemesFolder,
-                    getFileName(truthTableInputFileName) + "-out.tfc");
+                    getFileName(plaInputFileName) + "-out" + getSchemeFileExtension());
 
-                TfcFormatter formatter(inputCount, outputCount, outputVariablesOrder);
-                synthesizeScheme(table, resultsOutput, tfcOutputFileName, &formatter);
+                // cubes are implemented on output lines, which are added to input ones
+                float time = 0;
+                {
+                    AutoTimer timer(&time);
+
+                    GtGeneratorWithMemory generator;
+                    TfcFormatter formatter;
+
+                    writeSchemeFile(n + m, &formatter, tfcOutputFileName, [&](GateSink* sink)
+                    {
+                        generator.generateFromCubes(parser, sink, resultsOutput);
+                    });
+                }
+
+                resultsOutput << "Synthesis time: ";
+                resultsOutput << setiosflags(ios::fixed) << setprecision(2) << time / 1000 << " sec" << endl;
+                resultsOutput << "Scheme file: " << tfcOutputFileName << endl;
             }
             catch (exception& ex)
             {
                 resultsOutput << ex.what() << endl;
-                resultsOutput << "\n===============================================================" << endl;
             }
+
+            resultsOutput << "\n===============================================================" << endl;
         }
     }
 }
@@ -149,22 +326,24 @@ void processTfcFiles(ostream& resultsOutput, const string& schemesFolder)
         {
             try
             {
-                TfcFormatter formatter;
-                ifstream inputFile(tfcInputFileName);
-                assert(inputFile.is_open(),
-                    string("Failed to open input file \"") + tfcInputFileName + "\" for reading");
+                if (BinarySchemeReader::isBinarySchemeFile(tfcInputFileName))
+                    resultsOutput << "Binary scheme";
+                else
+                    resultsOutput << (RealFormatter::isRealFile(tfcInputFileName) ? "REAL" : "TFC");
 
-                resultsOutput << "TFC file: " << tfcInputFileName << endl;
+                resultsOutput << " file: " << tfcInputFileName << endl;
 
-                Scheme scheme = formatter.parse(inputFile);
+                TfcFormatter formatter;
+                uint variablesCount = 0;
+                Scheme scheme = parseSchemeFile(tfcInputFileName, &formatter, &variablesCount);
 
                 resultsOutput << "Original quantum cost: ";
                 resultsOutput << SchemeUtils::calculateQuantumCost(scheme) << endl;
 
-                TruthTable table = makePermutationFromScheme(scheme, formatter.getVariablesCount());
+                TruthTable table = makePermutationFromScheme(scheme, variablesCount);
 
                 string tfcOutputFileName = appendPath(schemesFolder,
-                    getFileName(tfcInputFileName) + "-out.tfc");
+                    getFileName(tfcInputFileName) + "-out" + getSchemeFileExtension());
 
                 synthesizeScheme(table, resultsOutput, tfcOutputFileName, &formatter);
             }
@@ -194,6 +373,8 @@ void generalSynthesis()
         _mkdir(schemesFolder.c_str());
 
     processTruthTables(resultsOutput, schemesFolder);
+    processTruthTableGenerators(resultsOutput, schemesFolder);
+    processPlaFiles(resultsOutput, schemesFolder);
     processTfcFiles(resultsOutput, schemesFolder);
 
     resultsOutput.close();
@@ -28,22 +28,34 @@ void printUsage(const string& fullProgramPath)
         "                       if not specified, default options would be used\n"
         "\n"
         "General options:\n"
-        "    work-mode = < general-synthesis | post-processing | discrete-log-synthesis | remove-negative-lines >\n"
+        "    work-mode = < general-synthesis | post-processing | discrete-log-synthesis | remove-negative-lines |\n"
+        "                  build-template-library | convert-truth-tables >\n"
         "    input-file = <filename>\n"
         "    truth-table-input = <filename>\n"
+        "    truth-table-generator = <name:arguments>\n"
+        "    pla-input = <filename>\n"
         "    tfc-input = <filename>\n"
         "    results-file = <filename>\n"
         "    schemes-folder = <foldername>\n"
+        "    binary-scheme-output = <bool>\n"
         "    rm-generator-weight-threshold = <number>\n"
         "    transpositions-pack-size = <number>\n"
+        "    gt-beam-width = <number>\n"
+        "    gt-beam-time-limit = <seconds>\n"
+        "    thread-count = <number>\n"
         "\n"
         "Optimization options:\n"
         "    do-post-optimization = <bool>\n"
         "    max-elements-distance-for-optimization = <number>\n"
         "    max-sub-scheme-size-for-optimization = <number>\n"
+        "    post-processing-time-limit = <seconds>\n"
         "    do-last-optimizations-with-full-scheme = <bool>\n"
         "    remove-negative-control-inputs = <bool>\n"
         "    use-swap-results-optimization-technique = <bool>\n"
+        "    do-optimal-resynthesis = <bool>\n"
+        "    do-depth-optimization = <bool>\n"
+        "    template-library = <filename>\n"
+        "    template-library-max-gate-count = <number>\n"
         "\n"
         "Tuning options:\n"
         "    enable-tuning = <bool>\n"
@@ -65,7 +77,9 @@ void printUsage(const string& fullProgramPath)
         "    enable-debug-behavior = <bool>\n"
         "    debug-log = <filename>\n"
         "    debug-context = <contextname>\n"
-        << endl;
+        "\n"
+        "Truth table generators:\n"
+        << ReversibleLogic::TruthTableGenerator::getUsage() << endl;
 }
 
 int main(int argc, const char* argv[])
@@ -75,6 +89,8 @@ int main(int argc, const char* argv[])
     const char* strDiscreteLogSynthesisMode = "discrete-log-synthesis";
     const char* strPostProcessingMode = "post-processing";
     const char* strRemoveNegativeLinesMode = "remove-negative-lines";
+    const char* strBuildTemplateLibraryMode = "build-template-library";
+    const char* strConvertTruthTablesMode = "convert-truth-tables";
 
     if (argc == 2)
     {
@@ -108,6 +124,10 @@ int main(int argc, const char* argv[])
             testOptimization();
         else if (workMode == strRemoveNegativeLinesMode)
             removeNegativeLines();
+        else if (workMode == strBuildTemplateLibraryMode)
+            buildTemplateLibrary();
+        else if (workMode == strConvertTruthTablesMode)
+            convertTruthTables();
         else
         {
             if (workMode.empty())
@@ -119,7 +139,9 @@ int main(int argc, const char* argv[])
                 "    " << strGeneralSynthesisMode << '\n' <<
                 "    " << strDiscreteLogSynthesisMode << '\n' <<
                 "    " << strPostProcessingMode << '\n' <<
-                "    " << strRemoveNegativeLinesMode << endl;
+                "    " << strRemoveNegativeLinesMode << '\n' <<
+                "    " << strBuildTemplateLibraryMode << '\n' <<
+                "    " << strConvertTruthTablesMode << endl;
         }
 
         ProgramOptions::uninit();
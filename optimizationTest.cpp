@@ -30,9 +30,29 @@ bool validateOptimizedScheme(const Scheme& before, const Scheme& after)
     else if (after.size())
         n = after.front().getInputCount();
 
-    word total = 1 << n;
-    for (word x = 0; x < total; ++x)
+    // all inputs are checked for small schemes, random inputs - for large ones
+    const uint numMaxExhaustiveInputCount = 16;
+    const uint numSampleCount = 1 << 16;
+
+    bool isExhaustive = (n <= numMaxExhaustiveInputCount);
+    word total = (isExhaustive ? (word)1 << n : numSampleCount);
+
+    word fullMask = getFullMask(n);
+    word seed = 0x9E3779B97F4A7C15ULL;
+
+    for (word index = 0; index < total; ++index)
     {
+        word x = index;
+        if (!isExhaustive)
+        {
+            // xorshift64
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+
+            x = seed & fullMask;
+        }
+
         word y = x;
         for (auto& element : before)
             y = element.getValue(y);
@@ -74,17 +94,15 @@ void testOptimization()
         {
             try
             {
-                ifstream inputFile(tfcInputFileName);
-                assert(inputFile.is_open(),
-                    string("Failed to open input file \"") + tfcInputFileName + "\" for reading");
-
                 outputFile << "Original scheme file: " << tfcInputFileName << endl;
 
                 TfcFormatter formatter;
-                Scheme scheme = formatter.parse(inputFile);
+                uint variablesCount = 0;
+                Scheme scheme = parseSchemeFile(tfcInputFileName, &formatter, &variablesCount);
 
                 uint elementCount = scheme.size();
                 outputFile << "Complexity before optimization: " << scheme.size() << endl;
+                outputFile << "Depth before optimization: " << SchemeUtils::calculateDepth(scheme) << endl;
 
                 PostProcessor optimizer;
                 Scheme optimizedScheme = optimizer.optimize(scheme);
@@ -92,16 +110,28 @@ void testOptimization()
                     string("Optimized scheme is not valid"));
 
                 outputFile << "Complexity after optimization: " << optimizedScheme.size() << endl;
-
-                string tfcOutputFileName = appendPath(schemesFolder,
-                    getFileName(tfcInputFileName) + "-opt.tfc");
-
-                ofstream tfcOutput(tfcOutputFileName);
-                assert(tfcOutput.is_open(),
-                    string("Failed to open tfc file \"") + tfcOutputFileName + "\" for writing");
-
-                formatter.format(tfcOutput, optimizedScheme);
-                outputFile << "Optimized scheme file: " << tfcOutputFileName << endl;
+                outputFile << "Depth after optimization: ";
+                outputFile << SchemeUtils::calculateDepth(optimizedScheme) << endl;
+
+                if (options.postProcessingTimeLimit)
+                    optimizer.logReport(outputFile);
+
+                if (RealFormatter::isRealFile(tfcInputFileName))
+                {
+                    string realOutputFileName = appendPath(schemesFolder,
+                        getFileName(tfcInputFileName) + "-opt.real");
+
+                    dumpSchemeInRealFormat(optimizedScheme, realOutputFileName);
+                    outputFile << "Optimized scheme file: " << realOutputFileName << endl;
+                }
+                else
+                {
+                    string tfcOutputFileName = appendPath(schemesFolder,
+                        getFileName(tfcInputFileName) + "-opt" + getSchemeFileExtension());
+
+                    writeSchemeFile(optimizedScheme, variablesCount, &formatter, tfcOutputFileName);
+                    outputFile << "Optimized scheme file: " << tfcOutputFileName << endl;
+                }
 
                 outputFile << "\n===============================================================\n";
                 outputFile.flush();
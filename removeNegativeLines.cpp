@@ -40,17 +40,11 @@ Scheme removeNegativeLines(const Scheme& scheme)
     return result;
 }
 
-void dumpSchemeInTfcFormat(const Scheme& scheme, const TfcFormatter& formatter,
+void dumpScheme(const Scheme& scheme, const TfcFormatter& formatter, uint variablesCount,
     const string& fileName)
 {
     TfcFormatter formatterCopy = formatter;
-
-    ofstream tfcOutput(fileName);
-    assert(tfcOutput.is_open(),
-        string("Failed to open tfc file \"") + fileName + "\" for writing");
-
-    formatterCopy.format(tfcOutput, scheme);
-    tfcOutput.close();
+    writeSchemeFile(scheme, variablesCount, &formatterCopy, fileName);
 }
 
 void dumpSchemeInRealFormat(const Scheme& scheme, const string& fileName)
@@ -60,93 +54,54 @@ void dumpSchemeInRealFormat(const Scheme& scheme, const string& fileName)
         string("Failed to open real file \"") + fileName + "\" for writing");
 
     uint n = 0;
-    uint index = 0;
-
     if (scheme.size())
         n = scheme.front().getInputCount();
 
-    // header
-    realOutput << ".version 1.0" << endl;
-    realOutput << ".numvars " << n << endl;
-
-    realOutput << ".variables";
-    index = 0;
-    while (index++ < n)
-        realOutput << " a" << index;
-    realOutput << endl;
-
-    realOutput << ".inputs";
-    index = 0;
-    while (index++ < n)
-        realOutput << " a" << index;
-    realOutput << endl;
-
-    realOutput << ".outputs";
-    index = 0;
-    while (index++ < n)
-        realOutput << " b" << index;
-    realOutput << endl;
-    
-    realOutput << ".constants ";
-    index = 0;
-    while (index++ < n)
-        realOutput << '-';
-    realOutput << endl;
-
-    realOutput << ".garbage ";
-    index = 0;
-    while (index++ < n)
-        realOutput << '-';
-    realOutput << endl;
-
-    realOutput << ".begin" << endl;
+    vector<string> inputNames;
+    vector<string> outputNames;
 
-    if (scheme.size())
+    for (uint index = 1; index <= n; ++index)
     {
-        realOutput << endl;
-
-        for (auto& element : scheme)
-        {
-            word targetMask = element.getTargetMask();
-            word controlMask = element.getControlMask();
-            word inversionMask = element.getInversionMask();
+        inputNames.push_back('a' + to_string(index));
+        outputNames.push_back('b' + to_string(index));
+    }
 
-            uint count = countNonZeroBits(controlMask) + 1;
+    SchemeWriter writer(realOutput, SchemeWriter::wfReal, inputNames);
 
-            ostringstream line;
-            line << 't' << count << ' ';
+    auto writeNames = [&writer](const char* prefix, const vector<string>& names)
+    {
+        writer.write(prefix);
+        for (auto& name : names)
+        {
+            writer.write(' ');
+            writer.write(name);
+        }
 
-            word mask = 1;
-            index = 1;
-            while (mask <= controlMask)
-            {
-                if (controlMask & mask)
-                {
-                    if (inversionMask & mask)
-                        line << '-';
+        writer.write('\n');
+    };
 
-                    line << 'a' << index << ' ';
-                }
+    // header
+    writer.write(".version 1.0\n");
+    writer.write(".numvars " + to_string(n) + '\n');
 
-                mask <<= 1;
-                ++index;
-            }
+    writeNames(".variables", inputNames);
+    writeNames(".inputs", inputNames);
+    writeNames(".outputs", outputNames);
 
-            mask = 1;
-            index = 1;
-            while (mask != targetMask)
-            {
-                mask <<= 1;
-                ++index;
-            }
+    writer.write(".constants " + string(n, '-') + '\n');
+    writer.write(".garbage " + string(n, '-') + '\n');
 
-            line << 'a' << index;
+    writer.write(".begin\n");
 
-            realOutput << line.str() << endl;
-        }
+    if (scheme.size())
+    {
+        writer.write('\n');
+        writer.writeElements(scheme);
     }
 
-    realOutput << "\n.end\n" << endl;
+    writer.write("\n.end\n\n");
+    writer.flush();
+
     realOutput.close();
 }
 
@@ -163,25 +118,23 @@ void processTfcFiles(const string& schemesFolder)
             try
             {
                 TfcFormatter formatter;
-                ifstream inputFile(tfcInputFileName);
-                assert(inputFile.is_open(),
-                    string("Failed to open input file \"") + tfcInputFileName + "\" for reading");
+                uint variablesCount = 0;
 
-                Scheme originalScheme = formatter.parse(inputFile);
+                Scheme originalScheme = parseSchemeFile(tfcInputFileName, &formatter, &variablesCount);
                 Scheme schemeWithoutNegativeLines = removeNegativeLines(originalScheme);
 
-                // TFC, with negative
+                // TFC or binary, with negative
                 {
                     string fileName = appendPath(schemesFolder,
-                        getFileName(tfcInputFileName) + "-with.tfc");
-                    dumpSchemeInTfcFormat(originalScheme, formatter, fileName);
+                        getFileName(tfcInputFileName) + "-with" + getSchemeFileExtension());
+                    dumpScheme(originalScheme, formatter, variablesCount, fileName);
                 }
 
-                // TFC, without negative
+                // TFC or binary, without negative
                 {
                     string fileName = appendPath(schemesFolder,
-                        getFileName(tfcInputFileName) + "-without.tfc");
-                    dumpSchemeInTfcFormat(schemeWithoutNegativeLines, formatter, fileName);
+                        getFileName(tfcInputFileName) + "-without" + getSchemeFileExtension());
+                    dumpScheme(schemeWithoutNegativeLines, formatter, variablesCount, fileName);
                 }
 
                 // Real, with negative
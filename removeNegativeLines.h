@@ -21,3 +21,6 @@
 #pragma once
 
 void removeNegativeLines();
+
+/// Writes @scheme to @fileName in RevLib .real format
+void dumpSchemeInRealFormat(const ReversibleLogic::Scheme& scheme, const string& fileName);
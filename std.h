@@ -28,4 +28,6 @@
 #include "discreteLogSynthesis.h"
 #include "optimizationTest.h"
 #include "removeNegativeLines.h"
+#include "buildTemplateLibrary.h"
+#include "convertTruthTables.h"
 #include "Gf2Field.h"